@@ -8,157 +8,1653 @@
 #include <limits>
 #include <iomanip>
 #include <fstream> // Necesario para escribir en archivos
+#include <charconv>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define DISK_REPLAY_LINUX 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 // --- Constantes del Disco ---
 const int MAX_CYLINDER = 4999;
 const int MIN_CYLINDER = 0;
-const int REQUEST_COUNT = 1000;
+const int REQUEST_COUNT = 1000;          // Solicitudes por defecto
+const long long MAX_REQUEST_COUNT = 100000000; // Máximo de solicitudes por lote (10^8)
 
 //Estructura para almacenar los resultados de un algoritmo
 struct SchedulingResult {
-    int movement = 0;
+    long long movement = 0; // 64 bits: con 10^8 solicitudes desborda un int
     std::vector<int> path;
 };
 
+// --- Kernel del movimiento total ---
+// Suma |path[i] - path[i - 1]|. Es el ciclo caliente de FCFS en lotes grandes,
+// así que hay versiones SSE4.1 y AVX2 que se eligen al ejecutar según la CPU,
+// con la versión escalar como respaldo. Las versiones vectoriales suman en
+// carriles de 32 bits por bloques que no pueden desbordar (cada diferencia
+// es a lo sumo MAX_CYLINDER - MIN_CYLINDER) y vuelcan cada bloque a
+// carriles de 64 bits
+
+using MovementKernel = long long (*)(const int* path, size_t n);
+
+long long movementScalar(const int* path, size_t n) {
+    long long movement = 0;
+    for (size_t i = 1; i < n; ++i) {
+        movement += std::abs(path[i] - path[i - 1]);
+    }
+    return movement;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define DISK_SIMD_X86 1
+
+// Iteraciones vectoriales por bloque sin desbordar un carril de 32 bits
+const size_t SIMD_BLOCK = std::numeric_limits<int>::max() / (MAX_CYLINDER - MIN_CYLINDER + 1);
+
+__attribute__((target("sse4.1")))
+long long movementSSE41(const int* path, size_t n) {
+    if (n < 2) return 0;
+    __m128i total = _mm_setzero_si128(); // 2 carriles de 64 bits
+    size_t i = 1;
+    while (i + 4 <= n) {
+        __m128i block = _mm_setzero_si128(); // 4 carriles de 32 bits
+        size_t end = std::min(n - 3, i + 4 * SIMD_BLOCK);
+        for (; i < end; i += 4) {
+            __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(path + i));
+            __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(path + i - 1));
+            block = _mm_add_epi32(block, _mm_abs_epi32(_mm_sub_epi32(cur, prev)));
+        }
+        total = _mm_add_epi64(total, _mm_cvtepu32_epi64(block));
+        total = _mm_add_epi64(total, _mm_cvtepu32_epi64(_mm_srli_si128(block, 8)));
+    }
+    long long lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), total);
+    return lanes[0] + lanes[1] + movementScalar(path + i - 1, n - i + 1);
+}
+
+__attribute__((target("avx2")))
+long long movementAVX2(const int* path, size_t n) {
+    if (n < 2) return 0;
+    __m256i total = _mm256_setzero_si256(); // 4 carriles de 64 bits
+    size_t i = 1;
+    while (i + 8 <= n) {
+        __m256i block = _mm256_setzero_si256(); // 8 carriles de 32 bits
+        size_t end = std::min(n - 7, i + 8 * SIMD_BLOCK);
+        for (; i < end; i += 8) {
+            __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(path + i));
+            __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(path + i - 1));
+            block = _mm256_add_epi32(block, _mm256_abs_epi32(_mm256_sub_epi32(cur, prev)));
+        }
+        total = _mm256_add_epi64(total, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(block)));
+        total = _mm256_add_epi64(total, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(block, 1)));
+    }
+    long long lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + movementScalar(path + i - 1, n - i + 1);
+}
+#endif
+
+// Elige una sola vez el mejor kernel que soporte la CPU
+MovementKernel movementKernel() {
+    static const MovementKernel kernel = [] {
+#ifdef DISK_SIMD_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return &movementAVX2;
+        if (__builtin_cpu_supports("sse4.1")) return &movementSSE41;
+#endif
+        return &movementScalar;
+    }();
+    return kernel;
+}
+
+// Lo que hace falta de un lote para calcular el movimiento de SCAN, C-SCAN,
+// LOOK y C-LOOK sin recorrer la ruta
+struct RequestSummary {
+    int initialPos = 0;
+    size_t count = 0;   // Cantidad de solicitudes
+    size_t below = 0;   // Solicitudes por debajo de initialPos
+    int minRequest = 0;
+    int maxRequest = 0;
+    int maxBelow = 0;   // Mayor solicitud por debajo de initialPos (si below > 0)
+};
+
+// Ruta de un algoritmo generada bajo demanda: se arma con unos pocos tramos
+// del lote (hacia adelante o hacia atrás) y cilindros sueltos, así que se
+// puede recorrer o escribir sin tener la ruta completa en memoria. SSTF no
+// se reduce a pocos tramos y se genera con sus dos punteros
+class PathStream {
+public:
+    // Cilindros que faltan por entregar
+    size_t remaining() const { return remaining_; }
+
+    // Copia hasta 'max' cilindros en 'out'; devuelve cuántos copió (0 al final)
+    size_t read(int* out, size_t max) {
+        size_t done = 0;
+        while (done < max && segment_ < segments_.size()) {
+            Segment& s = segments_[segment_];
+            size_t take = std::min(max - done, s.count);
+            if (s.data == nullptr) {
+                std::fill_n(out + done, take, s.value);
+            } else if (s.reversed) {
+                std::reverse_copy(s.data - take, s.data, out + done);
+                s.data -= take;
+            } else {
+                std::copy(s.data, s.data + take, out + done);
+                s.data += take;
+            }
+            s.count -= take;
+            done += take;
+            if (s.count == 0) segment_++;
+        }
+        if (sstf_) {
+            while (done < max && (left_ >= 0 || right_ < sstfCount_)) {
+                bool goLeft;
+                if (left_ < 0) goLeft = false;
+                else if (right_ >= sstfCount_) goLeft = true;
+                else goLeft = head_ - base_[left_] <= base_[right_] - head_;
+                head_ = goLeft ? base_[left_--] : base_[right_++];
+                out[done++] = head_;
+            }
+        }
+        remaining_ -= done;
+        return done;
+    }
+
+    // Tramos para armar la ruta
+    void addValue(int value) { segments_.push_back({nullptr, 1, false, value}); remaining_++; }
+    void addForward(const int* first, const int* last) {
+        if (last > first) segments_.push_back({first, size_t(last - first), false, 0});
+        remaining_ += last - first;
+    }
+    void addBackward(const int* first, const int* last) {
+        if (last > first) segments_.push_back({last, size_t(last - first), true, 0});
+        remaining_ += last - first;
+    }
+    // Recorrido SSTF sobre [sorted, sorted + count) desde head (después de los tramos ya puestos)
+    void setSSTF(const int* sorted, long long count, long long split, int head) {
+        sstf_ = true;
+        base_ = sorted;
+        sstfCount_ = count;
+        right_ = split;
+        left_ = split - 1;
+        head_ = head;
+        remaining_ += count;
+    }
+
+private:
+    struct Segment {
+        const int* data; // nullptr = cilindro suelto; si reversed, apunta al final del tramo
+        size_t count;
+        bool reversed;
+        int value;
+    };
+    std::vector<Segment> segments_;
+    size_t segment_ = 0;
+    size_t remaining_ = 0;
+
+    bool sstf_ = false;
+    const int* base_ = nullptr;
+    long long sstfCount_ = 0, left_ = 0, right_ = 0;
+    int head_ = 0;
+};
+
 // Clase con todos los algoritmos.
+// Los algoritmos que recorren el disco en orden (SCAN, C-SCAN, SSTF, LOOK y
+// C-LOOK) reciben las solicitudes ya ordenadas con sortRequests, así que un
+// lote se ordena una sola vez para todos. Cada algoritmo se puede pedir de
+// tres formas: la ruta completa (calculateX), la ruta bajo demanda
+// (streamX, que referencia al lote sin copiarlo) o solo el movimiento
+// (movementX, sin ruta)
 
 class DiskScheduler {
 private:
     //Calcula el movimiento total a partir de una ruta dada
-    int calculateMovementFromPath(const std::vector<int>& path) const {
-        int movement = 0;
-        for (size_t i = 1; i < path.size(); ++i) {
-            movement += std::abs(path[i] - path[i - 1]);
-        }
-        return movement;
+    long long calculateMovementFromPath(const std::vector<int>& path) const {
+        return movementKernel()(path.data(), path.size());
     }
 
-public:
-    DiskScheduler() {}
+    // Índice de la primera solicitud >= initialPos en las solicitudes ordenadas
+    static size_t splitIndexOf(int initialPos, const std::vector<int>& sorted) {
+        return std::lower_bound(sorted.begin(), sorted.end(), initialPos) - sorted.begin();
+    }
 
-    //Algoritmo FCFS
-    SchedulingResult calculateFCFS(int initialPos, std::vector<int> requests) const {
+    // Materializa una ruta bajo demanda en un vector de su tamaño exacto
+    SchedulingResult collect(PathStream stream) const {
         SchedulingResult result;
-        result.path.push_back(initialPos);
-        result.path.insert(result.path.end(), requests.begin(), requests.end());
+        result.path.resize(stream.remaining());
+        stream.read(result.path.data(), result.path.size());
         result.movement = calculateMovementFromPath(result.path);
         return result;
     }
 
-    // Algoritmo SCAN
-    SchedulingResult calculateSCAN(int initialPos, std::vector<int> requests) const {
-        SchedulingResult result;
-        result.path.push_back(initialPos);
-        
-        std::sort(requests.begin(), requests.end());
-        auto it = std::lower_bound(requests.begin(), requests.end(), initialPos);
-        int splitIndex = std::distance(requests.begin(), it);
+public:
+    DiskScheduler() {}
 
-        // 1. Moverse "arriba"
-        for (int i = splitIndex; i < requests.size(); ++i) {
-            result.path.push_back(requests[i]);
+    // Ordena un lote de solicitudes. Como los cilindros están acotados entre
+    // MIN_CYLINDER y MAX_CYLINDER, se usa ordenamiento por conteo: O(n + C)
+    static std::vector<int> sortRequests(const std::vector<int>& requests) {
+        std::vector<size_t> counts(MAX_CYLINDER - MIN_CYLINDER + 1, 0);
+        for (int c : requests) counts[c - MIN_CYLINDER]++;
+
+        std::vector<int> sorted(requests.size());
+        size_t pos = 0;
+        for (int c = MIN_CYLINDER; c <= MAX_CYLINDER; ++c) {
+            size_t count = counts[c - MIN_CYLINDER];
+            std::fill_n(sorted.begin() + pos, count, c);
+            pos += count;
         }
+        return sorted;
+    }
 
-        // Si hay solicitudes "abajo"
-        if (splitIndex > 0) {
-            result.path.push_back(MAX_CYLINDER); // Ir al final
-            // 2. Moverse "abajo"
-            for (int i = splitIndex - 1; i >= 0; --i) {
-                result.path.push_back(requests[i]);
+    // Resumen de un lote sin ordenar: una pasada, O(n)
+    static RequestSummary summarize(int initialPos, const std::vector<int>& requests) {
+        RequestSummary s;
+        s.initialPos = initialPos;
+        s.count = requests.size();
+        s.minRequest = MAX_CYLINDER;
+        s.maxRequest = MIN_CYLINDER;
+        s.maxBelow = MIN_CYLINDER;
+        for (int c : requests) {
+            s.minRequest = std::min(s.minRequest, c);
+            s.maxRequest = std::max(s.maxRequest, c);
+            if (c < initialPos) {
+                s.below++;
+                s.maxBelow = std::max(s.maxBelow, c);
             }
         }
-        
-        result.movement = calculateMovementFromPath(result.path);
-        return result;
+        return s;
     }
 
-    // Algoritmo C-SCAN
-    SchedulingResult calculateCSCAN(int initialPos, std::vector<int> requests) const {
-        SchedulingResult result;
-        result.path.push_back(initialPos);
-        
-        std::sort(requests.begin(), requests.end());
-        auto it = std::lower_bound(requests.begin(), requests.end(), initialPos);
-        int splitIndex = std::distance(requests.begin(), it);
+    // Resumen de un lote ya ordenado: O(log n)
+    static RequestSummary summarizeSorted(int initialPos, const std::vector<int>& sorted) {
+        RequestSummary s;
+        s.initialPos = initialPos;
+        s.count = sorted.size();
+        s.below = splitIndexOf(initialPos, sorted);
+        if (!sorted.empty()) {
+            s.minRequest = sorted.front();
+            s.maxRequest = sorted.back();
+        }
+        if (s.below > 0) s.maxBelow = sorted[s.below - 1];
+        return s;
+    }
+
+    // --- Rutas bajo demanda ---
 
+    PathStream streamFCFS(int initialPos, const std::vector<int>& requests) const {
+        PathStream stream;
+        stream.addValue(initialPos);
+        stream.addForward(requests.data(), requests.data() + requests.size());
+        return stream;
+    }
+
+    PathStream streamSCAN(int initialPos, const std::vector<int>& sorted) const {
+        PathStream stream;
+        size_t splitIndex = splitIndexOf(initialPos, sorted);
+        stream.addValue(initialPos);
         // 1. Moverse "arriba"
-        for (int i = splitIndex; i < requests.size(); ++i) {
-            result.path.push_back(requests[i]);
+        stream.addForward(sorted.data() + splitIndex, sorted.data() + sorted.size());
+        // Si hay solicitudes "abajo"
+        if (splitIndex > 0) {
+            stream.addValue(MAX_CYLINDER); // Ir al final
+            // 2. Moverse "abajo"
+            stream.addBackward(sorted.data(), sorted.data() + splitIndex);
         }
+        return stream;
+    }
 
+    PathStream streamCSCAN(int initialPos, const std::vector<int>& sorted) const {
+        PathStream stream;
+        size_t splitIndex = splitIndexOf(initialPos, sorted);
+        stream.addValue(initialPos);
+        // 1. Moverse "arriba"
+        stream.addForward(sorted.data() + splitIndex, sorted.data() + sorted.size());
         // Si hay solicitudes "abajo"
         if (splitIndex > 0) {
-            result.path.push_back(MAX_CYLINDER); // Ir al final
-            result.path.push_back(MIN_CYLINDER); // Saltar al inicio
-            
+            stream.addValue(MAX_CYLINDER); // Ir al final
+            stream.addValue(MIN_CYLINDER); // Saltar al inicio
             // 2. Continuar "arriba" desde el inicio
-            for (int i = 0; i < splitIndex; ++i) {
-                result.path.push_back(requests[i]);
-            }
+            stream.addForward(sorted.data(), sorted.data() + splitIndex);
         }
+        return stream;
+    }
 
-        result.movement = calculateMovementFromPath(result.path);
-        return result;
+    // SSTF
+    // Con las solicitudes ordenadas, las ya atendidas siempre forman un
+    // intervalo contiguo alrededor de la posición inicial: la más cercana es
+    // la de justo a la izquierda o la de justo a la derecha de ese intervalo.
+    // Basta con dos punteros, O(n) sobre el lote ya ordenado.
+    // En empate se atiende la de cilindro menor
+    PathStream streamSSTF(int initialPos, const std::vector<int>& sorted) const {
+        PathStream stream;
+        stream.addValue(initialPos);
+        stream.setSSTF(sorted.data(), sorted.size(), splitIndexOf(initialPos, sorted), initialPos);
+        return stream;
+    }
+
+    // LOOK: como SCAN, pero da la vuelta en la última solicitud en lugar de
+    // llegar hasta el final del disco
+    PathStream streamLOOK(int initialPos, const std::vector<int>& sorted) const {
+        PathStream stream;
+        size_t splitIndex = splitIndexOf(initialPos, sorted);
+        stream.addValue(initialPos);
+        // 1. Moverse "arriba"
+        stream.addForward(sorted.data() + splitIndex, sorted.data() + sorted.size());
+        // 2. Dar la vuelta y moverse "abajo"
+        stream.addBackward(sorted.data(), sorted.data() + splitIndex);
+        return stream;
+    }
+
+    // C-LOOK: como C-SCAN, pero salta de la última solicitud de arriba
+    // directamente a la primera de abajo
+    PathStream streamCLOOK(int initialPos, const std::vector<int>& sorted) const {
+        PathStream stream;
+        size_t splitIndex = splitIndexOf(initialPos, sorted);
+        stream.addValue(initialPos);
+        // 1. Moverse "arriba"
+        stream.addForward(sorted.data() + splitIndex, sorted.data() + sorted.size());
+        // 2. Saltar a la solicitud más baja y continuar "arriba"
+        stream.addForward(sorted.data(), sorted.data() + splitIndex);
+        return stream;
+    }
+
+    // --- Rutas completas ---
+
+    //Algoritmo FCFS
+    SchedulingResult calculateFCFS(int initialPos, const std::vector<int>& requests) const {
+        return collect(streamFCFS(initialPos, requests));
+    }
+
+    // Algoritmo SCAN
+    SchedulingResult calculateSCAN(int initialPos, const std::vector<int>& sorted) const {
+        return collect(streamSCAN(initialPos, sorted));
+    }
+
+    // Algoritmo C-SCAN
+    SchedulingResult calculateCSCAN(int initialPos, const std::vector<int>& sorted) const {
+        return collect(streamCSCAN(initialPos, sorted));
+    }
+
+    // Algoritmo SSTF
+    SchedulingResult calculateSSTF(int initialPos, const std::vector<int>& sorted) const {
+        return collect(streamSSTF(initialPos, sorted));
+    }
+
+    // Algoritmo LOOK
+    SchedulingResult calculateLOOK(int initialPos, const std::vector<int>& sorted) const {
+        return collect(streamLOOK(initialPos, sorted));
+    }
+
+    // Algoritmo C-LOOK
+    SchedulingResult calculateCLOOK(int initialPos, const std::vector<int>& sorted) const {
+        return collect(streamCLOOK(initialPos, sorted));
+    }
+
+    // --- Solo movimiento ---
+    // Para SCAN, C-SCAN, LOOK y C-LOOK el movimiento depende solo de la
+    // posición inicial, la solicitud mínima y máxima, la mayor por debajo de
+    // la posición inicial y los extremos del disco: O(1) con el resumen
+
+    long long movementFCFS(int initialPos, const std::vector<int>& requests) const {
+        if (requests.empty()) return 0;
+        return std::abs(requests[0] - initialPos) + movementKernel()(requests.data(), requests.size());
+    }
+
+    long long movementSCAN(const RequestSummary& s) const {
+        if (s.count == 0) return 0;
+        // Sin solicitudes abajo solo sube hasta la mayor; si las hay, sube
+        // hasta el final y baja hasta la menor
+        if (s.below == 0) return s.maxRequest - s.initialPos;
+        return (long long)(MAX_CYLINDER - s.initialPos) + (MAX_CYLINDER - s.minRequest);
+    }
+
+    long long movementCSCAN(const RequestSummary& s) const {
+        if (s.count == 0) return 0;
+        // Sube hasta el final, salta al inicio y sube hasta la mayor de abajo
+        if (s.below == 0) return s.maxRequest - s.initialPos;
+        return (long long)(MAX_CYLINDER - s.initialPos) + (MAX_CYLINDER - MIN_CYLINDER) +
+               (s.maxBelow - MIN_CYLINDER);
+    }
+
+    long long movementLOOK(const RequestSummary& s) const {
+        if (s.count == 0) return 0;
+        if (s.below == 0) return s.maxRequest - s.initialPos;
+        if (s.below == s.count) return s.initialPos - s.minRequest;
+        return (long long)(s.maxRequest - s.initialPos) + (s.maxRequest - s.minRequest);
+    }
+
+    long long movementCLOOK(const RequestSummary& s) const {
+        if (s.count == 0) return 0;
+        if (s.below == 0) return s.maxRequest - s.initialPos;
+        // Sube hasta la mayor (si hay arriba), salta a la menor y sube hasta la mayor de abajo
+        int top = s.below == s.count ? s.initialPos : s.maxRequest;
+        return (long long)(top - s.initialPos) + std::abs(top - s.minRequest) + (s.maxBelow - s.minRequest);
+    }
+
+    // SSTF no tiene forma cerrada: recorre los dos punteros sin guardar la ruta, O(n)
+    long long movementSSTF(int initialPos, const std::vector<int>& sorted) const {
+        long long movement = 0;
+        long long right = splitIndexOf(initialPos, sorted);
+        long long left = right - 1;
+        const long long n = sorted.size();
+        int head = initialPos;
+        while (left >= 0 || right < n) {
+            bool goLeft;
+            if (left < 0) goLeft = false;
+            else if (right >= n) goLeft = true;
+            else goLeft = head - sorted[left] <= sorted[right] - head;
+            int next = goLeft ? sorted[left--] : sorted[right++];
+            movement += std::abs(next - head);
+            head = next;
+        }
+        return movement;
     }
 };
 
+//Guarda una ruta en un archivo de texto a medida que se genera. Los números
+// se formatean en un buffer y se escriben por bloques, así que la memoria no
+// depende del largo de la ruta
+void savePathToFile(const std::string& filename, PathStream path) {
+    std::ofstream outFile(filename, std::ios::binary);
+    if (!outFile.is_open()) {
+        std::cerr << "Error: No se pudo abrir el archivo para escribir: " << filename << std::endl;
+        return;
+    }
+    const size_t CHUNK = 1 << 16;
+    std::vector<int> values(CHUNK);
+    std::vector<char> text(CHUNK * 12);
+    bool first = true;
+    size_t n;
+    while ((n = path.read(values.data(), CHUNK)) > 0) {
+        char* out = text.data();
+        for (size_t i = 0; i < n; ++i) {
+            if (!first) *out++ = ' ';
+            first = false;
+            out = std::to_chars(out, text.data() + text.size(), values[i]).ptr;
+        }
+        outFile.write(text.data(), out - text.data());
+    }
+    outFile.close();
+}
+
 //Guarda un vector en un archivo de texto
 void savePathToFile(const std::string& filename, const std::vector<int>& path) {
-    std::ofstream outFile(filename);
+    PathStream stream;
+    stream.addForward(path.data(), path.data() + path.size());
+    savePathToFile(filename, stream);
+}
+
+// Formato binario de rutas: encabezado de 24 bytes (little-endian) seguido de
+// un varint por cilindro con la diferencia zig-zag respecto al anterior (el
+// primero respecto a 0). Como cada diferencia cabe en a lo sumo 2 bytes, el
+// archivo ocupa menos de la mitad que el texto y se decodifica sin parsear:
+// con numpy, los bytes < 0x80 cierran cada varint y un cumsum rearma la ruta
+struct BinaryPathHeader {
+    char magic[8];     // "DSKPATH1"
+    uint64_t count;    // Cilindros en la ruta
+    int32_t minCylinder;
+    int32_t maxCylinder;
+};
+static_assert(sizeof(BinaryPathHeader) == 24, "encabezado binario de 24 bytes");
+
+// Serializa el encabezado campo por campo en little-endian, así el archivo es
+// el mismo sin importar el orden de bytes de la máquina que lo escribe
+void writeBinaryPathHeader(std::ostream& out, const BinaryPathHeader& header) {
+    unsigned char bytes[sizeof(BinaryPathHeader)];
+    auto store = [&bytes](size_t offset, uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; ++i) bytes[offset + i] = (unsigned char)(value >> (8 * i));
+    };
+    std::memcpy(bytes, header.magic, 8);
+    store(8, header.count, 8);
+    store(16, uint32_t(header.minCylinder), 4);
+    store(20, uint32_t(header.maxCylinder), 4);
+    out.write(reinterpret_cast<const char*>(bytes), sizeof(bytes));
+}
+
+//Guarda una ruta en formato binario a medida que se genera. Cada bloque se
+// codifica en un buffer y se escribe con una sola llamada
+void savePathToBinaryFile(const std::string& filename, PathStream path) {
+    std::ofstream outFile(filename, std::ios::binary);
     if (!outFile.is_open()) {
         std::cerr << "Error: No se pudo abrir el archivo para escribir: " << filename << std::endl;
         return;
     }
-    for (size_t i = 0; i < path.size(); ++i) {
-        outFile << path[i] << (i == path.size() - 1 ? "" : " ");
+    BinaryPathHeader header = {{'D', 'S', 'K', 'P', 'A', 'T', 'H', '1'}, path.remaining(), MIN_CYLINDER, MAX_CYLINDER};
+    writeBinaryPathHeader(outFile, header);
+
+    const size_t CHUNK = 1 << 16;
+    std::vector<int> values(CHUNK);
+    std::vector<unsigned char> bytes(CHUNK * 5);
+    int previous = 0;
+    size_t n;
+    while ((n = path.read(values.data(), CHUNK)) > 0) {
+        unsigned char* out = bytes.data();
+        for (size_t i = 0; i < n; ++i) {
+            int delta = values[i] - previous;
+            previous = values[i];
+            uint32_t zigzag = (uint32_t(delta) << 1) ^ uint32_t(delta >> 31);
+            while (zigzag >= 0x80) {
+                *out++ = (unsigned char)(zigzag | 0x80);
+                zigzag >>= 7;
+            }
+            *out++ = (unsigned char)zigzag;
+        }
+        outFile.write(reinterpret_cast<const char*>(bytes.data()), out - bytes.data());
     }
     outFile.close();
 }
 
+// --- Generación de solicitudes ---
+
+// Generador xoshiro256** sembrado con splitmix64: mucho más rápido que
+// std::rand() y con la misma secuencia para la misma semilla en cualquier
+// plataforma
+class FastRandom {
+public:
+    explicit FastRandom(uint64_t seed) {
+        for (uint64_t& s : state) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotate(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotate(state[3], 45);
+        return result;
+    }
+
+    // Entero uniforme en [0, n) (multiplicación en vez de módulo)
+    uint32_t below(uint32_t n) { return (uint32_t)(((next() >> 32) * n) >> 32); }
+    // Uniforme en [0, 1)
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+private:
+    static uint64_t rotate(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+    uint64_t state[4];
+};
+
+// Distribuciones de solicitudes
+enum class Distribution { UNIFORM, ZIPF, SEQUENTIAL, MIXED };
+
+struct DistributionEntry {
+    const char* name;
+    Distribution distribution;
+};
+const DistributionEntry DISTRIBUTIONS[] = {
+    {"uniforme", Distribution::UNIFORM},
+    {"zipf", Distribution::ZIPF},
+    {"secuencial", Distribution::SEQUENTIAL},
+    {"mixta", Distribution::MIXED},
+};
+
+const char* distributionName(Distribution distribution) {
+    for (const DistributionEntry& d : DISTRIBUTIONS) {
+        if (d.distribution == distribution) return d.name;
+    }
+    return "?";
+}
+
+// Parámetros de las distribuciones
+struct WorkloadParams {
+    double zipfExponent = 1.0;     // ZIPF: peso del cilindro de rango k es 1/k^s
+    double meanRun = 32;           // SEQUENTIAL y MIXED: largo medio de cada racha
+    double sequentialShare = 0.5;  // MIXED: fracción de solicitudes que van en rachas
+};
+
+// Genera 'count' posiciones de [first, first + size) con la distribución pedida:
+// - UNIFORM: cualquier posición con la misma probabilidad.
+// - ZIPF: puntos calientes; los rangos de Zipf se asignan a posiciones en un
+//   orden aleatorio, así que los calientes quedan dispersos por el disco.
+// - SEQUENTIAL: rachas de posiciones consecutivas (largo geométrico) desde
+//   una al azar, como lecturas secuenciales de archivos.
+// - MIXED: rachas secuenciales intercaladas con solicitudes uniformes sueltas
+std::vector<int> generatePositions(long long count, int first, int size, Distribution distribution,
+                                   FastRandom& rng, const WorkloadParams& params) {
+    const int cylinders = size;
+    const int last = first + size - 1;
+    std::vector<int> requests(count);
+
+    if (distribution == Distribution::UNIFORM) {
+        for (long long i = 0; i < count; ++i) requests[i] = first + (int)rng.below(cylinders);
+        return requests;
+    }
+
+    if (distribution == Distribution::ZIPF) {
+        std::vector<int> order(cylinders);
+        for (int c = 0; c < cylinders; ++c) order[c] = first + c;
+        for (int c = cylinders - 1; c > 0; --c) std::swap(order[c], order[rng.below(c + 1)]);
+        std::vector<double> cdf(cylinders);
+        double total = 0;
+        for (int k = 0; k < cylinders; ++k) cdf[k] = total += std::pow(k + 1.0, -params.zipfExponent);
+        for (long long i = 0; i < count; ++i) {
+            size_t k = std::upper_bound(cdf.begin(), cdf.end(), rng.uniform() * total) - cdf.begin();
+            requests[i] = order[std::min<size_t>(k, cylinders - 1)];
+        }
+        return requests;
+    }
+
+    // SEQUENTIAL y MIXED: una racha sigue con probabilidad 1 - 1/meanRun.
+    // Una racha empieza con probabilidad q, elegida para que la fracción de
+    // solicitudes en rachas sea sequentialShare: qL / (qL + 1 - q) = p
+    const double share = distribution == Distribution::SEQUENTIAL ? 1 : params.sequentialShare;
+    const double meanRun = std::max(1.0, params.meanRun);
+    const double runStart = share / (share + meanRun * (1 - share));
+    const double keepRunning = 1 - 1 / meanRun;
+    int position = -1; // -1 = sin racha en curso
+    for (long long i = 0; i < count; ++i) {
+        if (position >= 0 && rng.uniform() < keepRunning) {
+            position = position == last ? first : position + 1;
+            requests[i] = position;
+            continue;
+        }
+        int cylinder = first + (int)rng.below(cylinders);
+        position = rng.uniform() < runStart ? cylinder : -1;
+        requests[i] = cylinder;
+    }
+    return requests;
+}
+
+// Genera 'count' cilindros del disco con la distribución pedida
+std::vector<int> generateRequests(long long count, Distribution distribution, FastRandom& rng,
+                                  const WorkloadParams& params = WorkloadParams()) {
+    return generatePositions(count, MIN_CYLINDER, MAX_CYLINDER - MIN_CYLINDER + 1, distribution, rng, params);
+}
+
+
+// Algoritmos por nombre (para la línea de comandos) con su archivo de ruta
+struct AlgorithmEntry {
+    const char* name;
+    const char* label;
+    const char* filename;
+    PathStream (DiskScheduler::*stream)(int, const std::vector<int>&) const;
+    bool usesSorted;
+};
+const AlgorithmEntry ALGORITHMS[] = {
+    {"fcfs", "FCFS  ", "fcfs_path.txt", &DiskScheduler::streamFCFS, false},
+    {"scan", "SCAN  ", "scan_path.txt", &DiskScheduler::streamSCAN, true},
+    {"cscan", "C-SCAN", "cscan_path.txt", &DiskScheduler::streamCSCAN, true},
+    {"sstf", "SSTF  ", "sstf_path.txt", &DiskScheduler::streamSSTF, true},
+    {"look", "LOOK  ", "look_path.txt", &DiskScheduler::streamLOOK, true},
+    {"clook", "C-LOOK", "clook_path.txt", &DiskScheduler::streamCLOOK, true},
+};
+
+const AlgorithmEntry* findAlgorithm(const std::string& name) {
+    for (const AlgorithmEntry& a : ALGORITHMS) {
+        if (name == a.name) return &a;
+    }
+    return nullptr;
+}
+
+
+// --- Simulación con llegadas en el tiempo ---
+
+// Percentil q (0..1) por selección, O(n) (reordena values)
+double percentile(std::vector<double>& values, double q) {
+    size_t k = (size_t)std::ceil(q * values.size());
+    k = std::min(values.size() - 1, k > 0 ? k - 1 : 0);
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+// Modelo de tiempo del disco, en milisegundos: la búsqueda crece con la raíz
+// de la distancia (aceleración del brazo), más la latencia rotacional
+// (uniforme entre 0 y una vuelta) y la transferencia de cada solicitud
+struct DiskTimingModel {
+    double seekBase = 0.8;   // ms de cualquier búsqueda con distancia > 0
+    double seekSqrt = 0.12;  // ms por raíz de cilindros recorridos
+    double rpm = 7200;       // Velocidad de rotación
+    double transfer = 0.05;  // ms de transferencia por solicitud
 
-int main() {
+    double seekTime(int distance) const {
+        return distance == 0 ? 0 : seekBase + seekSqrt * std::sqrt((double)distance);
+    }
+    double rotationTime() const { return 60000.0 / rpm; }
+};
+
+// Resultado de una simulación con llegadas
+struct LatencyResult {
+    long long movement = 0;
+    double makespan = 0;    // ms desde la primera llegada hasta el último servicio
+    double throughput = 0;  // Solicitudes por segundo
+    double meanLatency = 0; // ms entre la llegada y el fin del servicio
+    double p50 = 0, p99 = 0, maxLatency = 0;
+};
+
+// Planificador dirigido por eventos: las solicitudes llegan en sus tiempos
+// y el cabezal atiende las pendientes según la política. FCFS sirve por
+// orden de llegada; SCAN y C-SCAN barren el disco (SCAN llega hasta el borde
+// y da la vuelta, C-SCAN vuelve al cilindro 0); DEADLINE barre como SCAN
+// pero atiende primero la solicitud más vieja si ya esperó más que el plazo,
+// para acotar la inanición de las solicitudes lejanas. Como el fifo_batch del
+// planificador deadline de Linux, el plazo solo se revisa cada DEADLINE_BATCH
+// servicios: tras saltar a una vencida se sigue barriendo desde su cilindro,
+// así que bajo sobrecarga (todas vencidas) no degenera en FCFS
+class DynamicDiskScheduler {
+public:
+    enum class Policy { FCFS, SCAN, CSCAN, DEADLINE };
+    static constexpr int DEADLINE_BATCH = 16;
+
+    DynamicDiskScheduler(const DiskTimingModel& model, uint64_t seed, double deadlineMs)
+        : model(model), seed(seed), deadlineMs(deadlineMs) {}
+
+    // arrivals (ms, en orden no decreciente) y cylinders describen las solicitudes
+    LatencyResult run(Policy policy, int initialPos, const std::vector<double>& arrivals,
+                      const std::vector<int>& cylinders) const {
+        const size_t n = arrivals.size();
+        const int C = MAX_CYLINDER - MIN_CYLINDER + 1;
+        LatencyResult result;
+        if (n == 0) return result;
+
+        // Pendientes por cilindro: una cola FIFO enlazada por índices y un
+        // mapa de bits de cilindros con pendientes para hallar el siguiente
+        std::vector<long long> first(C, -1), last(C, -1), next(n, -1);
+        std::vector<uint64_t> occupied((C + 63) / 64, 0);
+        std::vector<char> served(n, 0);
+        std::vector<double> latency(n);
+        // La misma semilla para todas las políticas: las mismas rotaciones en el mismo orden
+        FastRandom rng(seed);
+        auto rotation = [&]() { return rng.uniform() * model.rotationTime(); };
+
+        double now = 0;
+        int head = initialPos;
+        int dir = +1;
+        size_t admitted = 0, done = 0, oldest = 0;
+        int batch = 0; // Servicios que faltan para volver a revisar el plazo (DEADLINE)
+
+        auto admit = [&]() {
+            for (; admitted < n && arrivals[admitted] <= now; ++admitted) {
+                int c = cylinders[admitted] - MIN_CYLINDER;
+                if (last[c] < 0) first[c] = admitted;
+                else next[last[c]] = admitted;
+                last[c] = admitted;
+                occupied[c / 64] |= 1ULL << (c % 64);
+            }
+        };
+        auto popCylinder = [&](int c) {
+            long long r = first[c];
+            first[c] = next[r];
+            if (first[c] < 0) {
+                last[c] = -1;
+                occupied[c / 64] &= ~(1ULL << (c % 64));
+            }
+            return r;
+        };
+        auto moveTo = [&](int cylinder) {
+            int distance = std::abs(cylinder - head);
+            now += model.seekTime(distance);
+            result.movement += distance;
+            head = cylinder;
+        };
+        // Cilindro con pendientes más cercano desde head en la dirección d (incluye head); -1 si no hay
+        auto nearest = [&](int d) {
+            int c = head - MIN_CYLINDER;
+            while (c >= 0 && c < C) {
+                uint64_t word = occupied[c / 64];
+                if (word == 0) {
+                    c = d > 0 ? (c / 64 + 1) * 64 : (c / 64) * 64 - 1;
+                    continue;
+                }
+                if (word & (1ULL << (c % 64))) return c + MIN_CYLINDER;
+                c += d;
+            }
+            return -1;
+        };
+
+        while (done < n) {
+            // Disco ocioso: saltar a la siguiente llegada
+            if (done == admitted) now = std::max(now, arrivals[admitted]);
+            admit();
+
+            long long r = -1;
+            if (policy == Policy::FCFS) {
+                r = done; // Orden de llegada
+                int c = cylinders[r] - MIN_CYLINDER;
+                popCylinder(c);
+            } else {
+                if (policy == Policy::DEADLINE && batch == 0) {
+                    while (served[oldest]) oldest++;
+                    // La más vieja de todas es también la primera de su cilindro
+                    if (now - arrivals[oldest] >= deadlineMs) r = popCylinder(cylinders[oldest] - MIN_CYLINDER);
+                    batch = DEADLINE_BATCH;
+                }
+                if (r < 0) {
+                    int c = nearest(dir);
+                    if (c < 0) {
+                        // Nada más adelante: llegar al borde y dar la vuelta (SCAN)
+                        // o volver al inicio (C-SCAN)
+                        if (policy == Policy::CSCAN) {
+                            moveTo(MAX_CYLINDER);
+                            moveTo(MIN_CYLINDER);
+                        } else {
+                            moveTo(dir > 0 ? MAX_CYLINDER : MIN_CYLINDER);
+                            dir = -dir;
+                        }
+                        continue;
+                    }
+                    r = popCylinder(c - MIN_CYLINDER);
+                }
+                if (policy == Policy::DEADLINE) batch--;
+            }
+
+            moveTo(cylinders[r]);
+            now += rotation() + model.transfer;
+            latency[r] = now - arrivals[r];
+            served[r] = 1;
+            done++;
+            admit();
+        }
+
+        result.makespan = now - arrivals[0];
+        result.throughput = result.makespan > 0 ? n * 1000.0 / result.makespan : 0;
+        double sum = 0;
+        for (double l : latency) sum += l;
+        result.meanLatency = sum / n;
+        result.p50 = percentile(latency, 0.50);
+        result.p99 = percentile(latency, 0.99);
+        result.maxLatency = *std::max_element(latency.begin(), latency.end());
+        return result;
+    }
+
+private:
+    DiskTimingModel model;
+    uint64_t seed;
+    double deadlineMs;
+};
+
+// Corre todas las políticas sobre solicitudes que llegan como un proceso de
+// Poisson de 'rate' solicitudes por segundo, con los cilindros de la
+// distribución pedida (los mismos que generaría el modo por lotes)
+void runDynamicSimulation(int initialPos, long long count, double rate, uint64_t seed,
+                          Distribution distribution, const WorkloadParams& params,
+                          double deadlineMs, const DiskTimingModel& model) {
+    FastRandom rng(seed);
+    std::vector<int> cylinders = generateRequests(count, distribution, rng, params);
+    std::vector<double> arrivals(count);
+    double now = 0;
+    for (long long i = 0; i < count; ++i) {
+        now += -std::log(1 - rng.uniform()) * 1000.0 / rate; // ms entre llegadas (exponencial)
+        arrivals[i] = now;
+    }
+
+    DynamicDiskScheduler scheduler(model, seed, deadlineMs);
+    struct Entry {
+        const char* label;
+        DynamicDiskScheduler::Policy policy;
+    };
+    const Entry policies[] = {
+        {"FCFS    ", DynamicDiskScheduler::Policy::FCFS},
+        {"SCAN    ", DynamicDiskScheduler::Policy::SCAN},
+        {"C-SCAN  ", DynamicDiskScheduler::Policy::CSCAN},
+        {"DEADLINE", DynamicDiskScheduler::Policy::DEADLINE},
+    };
+
+    std::cout << "\nSimulacion con llegadas en el tiempo" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+    std::cout << "Solicitudes: " << count << " | Tasa: " << rate << " sol/s | Semilla: " << seed
+              << " | Distribucion: " << distributionName(distribution)
+              << " | Plazo DEADLINE: " << deadlineMs << " ms" << std::endl;
+    std::cout << "Busqueda: " << model.seekBase << " + " << model.seekSqrt << " * sqrt(d) ms | "
+              << model.rpm << " rpm | Transferencia: " << model.transfer << " ms" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+    std::cout << "Algoritmo | Throughput (sol/s) | Latencia media (ms) | p50 | p99 | max | Movimiento" << std::endl;
+    for (const Entry& e : policies) {
+        LatencyResult r = scheduler.run(e.policy, initialPos, arrivals, cylinders);
+        std::cout << e.label << "  | " << std::fixed << std::setprecision(1) << r.throughput << " | "
+                  << std::setprecision(2) << r.meanLatency << " | " << r.p50 << " | " << r.p99 << " | "
+                  << r.maxLatency << " | " << r.movement << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+    }
+}
+
+// Arreglo de K discos con franjas (RAID 0): el espacio lógico se reparte en
+// franjas de 'stripe' bloques consecutivos, una por disco en turno. Cada
+// disco tiene un bloque por cilindro y solo se usan franjas completas
+struct StripedArray {
+    int disks;
+    int stripe;
+
+    long long stripesPerDisk() const { return (MAX_CYLINDER - MIN_CYLINDER + 1) / stripe; }
+    long long capacity() const { return (long long)disks * stripesPerDisk() * stripe; }
+    int diskOf(long long block) const { return (int)((block / stripe) % disks); }
+    int cylinderOf(long long block) const {
+        return MIN_CYLINDER + (int)((block / stripe / disks) * stripe + block % stripe);
+    }
+};
+
+// Resultado de un disco del arreglo
+struct DiskRunResult {
+    long long requests = 0;
+    long long movement = 0;
+    double completion = 0; // ms hasta terminar su cola
+};
+
+// Reparte el lote lógico entre los discos y planifica la cola de cada uno
+// con el algoritmo elegido en su propio hilo. El tiempo de cada disco suma
+// búsqueda, media vuelta de latencia rotacional y transferencia por solicitud
+std::vector<DiskRunResult> runStripedArray(const StripedArray& array, const AlgorithmEntry& algorithm,
+                                           int initialPos, const std::vector<long long>& blocks,
+                                           const DiskTimingModel& model) {
+    std::vector<std::vector<int>> queues(array.disks);
+    for (long long block : blocks) {
+        queues[array.diskOf(block)].push_back(array.cylinderOf(block));
+    }
+
+    std::vector<DiskRunResult> results(array.disks);
+    auto worker = [&](int d) {
+        const std::vector<int>& requests = queues[d];
+        DiskRunResult& r = results[d];
+        r.requests = requests.size();
+        if (requests.empty()) return;
+        std::vector<int> sorted;
+        if (algorithm.usesSorted) sorted = DiskScheduler::sortRequests(requests);
+        DiskScheduler scheduler;
+        PathStream stream = (scheduler.*algorithm.stream)(initialPos, algorithm.usesSorted ? sorted : requests);
+
+        // La ruta empieza en la posición inicial (o la incluye); se recorre por bloques
+        std::vector<int> chunk(1 << 16);
+        int head = initialPos;
+        while (size_t n = stream.read(chunk.data(), chunk.size())) {
+            for (size_t i = 0; i < n; ++i) {
+                int distance = std::abs(chunk[i] - head);
+                r.movement += distance;
+                r.completion += model.seekTime(distance);
+                head = chunk[i];
+            }
+        }
+        r.completion += r.requests * (model.rotationTime() / 2 + model.transfer);
+    };
+
+    std::vector<std::thread> threads;
+    for (int d = 0; d < array.disks; ++d) threads.emplace_back(worker, d);
+    for (std::thread& t : threads) t.join();
+    return results;
+}
+
+// Genera bloques lógicos con la distribución pedida (las rachas secuenciales
+// recorren bloques lógicos consecutivos, así que cruzan de disco en disco),
+// los corre sobre el arreglo e imprime el movimiento y el tiempo de cada
+// disco y del arreglo completo
+void runArraySimulation(const StripedArray& array, const AlgorithmEntry& algorithm, int initialPos,
+                        long long count, uint64_t seed, Distribution distribution,
+                        const WorkloadParams& params, const DiskTimingModel& model) {
+    FastRandom rng(seed);
+    std::vector<int> positions = generatePositions(count, 0, (int)array.capacity(), distribution, rng, params);
+    std::vector<long long> blocks(positions.begin(), positions.end());
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<DiskRunResult> results = runStripedArray(array, algorithm, initialPos, blocks, model);
+    double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\nSimulacion de Arreglo con Franjas" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+    std::cout << "Discos: " << array.disks << " | Franja: " << array.stripe << " bloques | Capacidad: "
+              << array.capacity() << " bloques" << std::endl;
+    std::cout << "Algoritmo: " << algorithm.label << " | Solicitudes: " << count << " | Semilla: " << seed
+              << " | Distribucion: " << distributionName(distribution) << std::endl;
+    std::cout << "Posicion inicial del cabezal: " << initialPos << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+
+    long long totalMovement = 0;
+    double makespan = 0, busy = 0;
+    for (int d = 0; d < array.disks; ++d) {
+        const DiskRunResult& r = results[d];
+        std::cout << "Disco " << d << " | Solicitudes: " << r.requests << " | Movimiento Total: " << r.movement
+                  << " | Tiempo (ms): " << std::fixed << std::setprecision(2) << r.completion << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+        totalMovement += r.movement;
+        makespan = std::max(makespan, r.completion);
+        busy += r.completion;
+    }
+    std::cout << "------------------------------------" << std::endl;
+    std::cout << "Arreglo | Movimiento Total: " << totalMovement << " | Tiempo (ms): " << std::fixed
+              << std::setprecision(2) << makespan << " | Balance: " << (makespan > 0 ? busy / array.disks / makespan : 1)
+              << " | Throughput (sol/s): " << (makespan > 0 ? count * 1000.0 / makespan : 0) << std::endl;
+    std::cout << "Tiempo de simulacion (s): " << std::setprecision(3) << wall << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+}
+
+// --- Reproducción con E/S real ---
+
+#ifdef DISK_REPLAY_LINUX
+// Anillo de io_uring mínimo sobre las llamadas al sistema (sin liburing):
+// lecturas a la cola de envío, una llamada a io_uring_enter por lote y
+// cosecha de la cola de terminación
+class IoUring {
+public:
+    explicit IoUring(unsigned entries) {
+        io_uring_params params{};
+        fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) return;
+        sqEntries = params.sq_entries;
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        cqRing = single ? sqRing
+                        : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMap == MAP_FAILED) {
+            release();
+            return;
+        }
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        sqes = static_cast<io_uring_sqe*>(sqesMap);
+    }
+    ~IoUring() { release(); }
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    bool ok() const { return sqes != nullptr; }
+
+    // Encola una lectura; false si la cola de envío está llena
+    bool read(int file, void* buffer, unsigned length, uint64_t offset, uint64_t userData) {
+        unsigned tail = *sqTail;
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries) return false;
+        unsigned index = tail & sqMask;
+        io_uring_sqe& sqe = sqes[index];
+        sqe = io_uring_sqe{};
+        sqe.opcode = IORING_OP_READ;
+        sqe.fd = file;
+        sqe.addr = reinterpret_cast<uint64_t>(buffer);
+        sqe.len = length;
+        sqe.off = offset;
+        sqe.user_data = userData;
+        sqArray[index] = index;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        queued++;
+        return true;
+    }
+
+    // Envía lo encolado y espera al menos 'waitFor' terminaciones
+    bool submit(unsigned waitFor) {
+        int done = (int)syscall(__NR_io_uring_enter, fd, queued, waitFor, waitFor > 0 ? IORING_ENTER_GETEVENTS : 0,
+                                nullptr, 0);
+        if (done < 0) return false;
+        queued -= done;
+        return true;
+    }
+
+    // Saca una terminación si hay alguna lista
+    bool complete(uint64_t& userData, int& result) {
+        unsigned head = *cqHead;
+        if (head == __atomic_load_n(cqTail, __ATOMIC_ACQUIRE)) return false;
+        const io_uring_cqe& cqe = cqes[head & cqMask];
+        userData = cqe.user_data;
+        result = cqe.res;
+        __atomic_store_n(cqHead, head + 1, __ATOMIC_RELEASE);
+        return true;
+    }
+
+private:
+    void release() {
+        if (sqes != nullptr) munmap(sqes, sqesSize);
+        if (cqRing != nullptr && cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing != nullptr && sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+        if (fd >= 0) close(fd);
+        sqes = nullptr;
+        sqRing = cqRing = nullptr;
+        fd = -1;
+    }
+
+    int fd = -1;
+    unsigned sqEntries = 0, queued = 0;
+    size_t sqRingSize = 0, cqRingSize = 0, sqesSize = 0;
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    unsigned *sqHead = nullptr, *sqTail = nullptr, *sqArray = nullptr, sqMask = 0;
+    unsigned *cqHead = nullptr, *cqTail = nullptr, cqMask = 0;
+    io_uring_cqe* cqes = nullptr;
+    io_uring_sqe* sqes = nullptr;
+};
+
+// Mediciones de una reproducción
+struct ReplayResult {
+    long long reads = 0;
+    double seconds = 0;
+    std::vector<double> latencyUs; // Por lectura, desde el envío hasta la terminación
+};
+
+// Lee los bloques en 'offsets' en ese orden, con hasta 'depth' lecturas en
+// vuelo por io_uring (o de a una con pread si 'ring' es nullptr)
+bool replayReads(int file, const std::vector<uint64_t>& offsets, size_t block, unsigned depth, IoUring* ring,
+                 ReplayResult& result) {
+    using Clock = std::chrono::steady_clock;
+    if (ring == nullptr) depth = 1;
+    void* memory = nullptr;
+    if (posix_memalign(&memory, 4096, block * depth) != 0) {
+        std::cerr << "Error: no se pudo reservar el buffer de lectura" << std::endl;
+        return false;
+    }
+    std::unique_ptr<char, decltype(&std::free)> buffers(static_cast<char*>(memory), &std::free);
+    const size_t n = offsets.size();
+    std::vector<Clock::time_point> issued(n);
+    result.reads = n;
+    result.latencyUs.assign(n, 0);
+
+    auto finish = [&](size_t i, long long bytes) {
+        if (bytes != (long long)block) {
+            std::cerr << "Error: lectura fallida en el desplazamiento " << offsets[i] << " ("
+                      << (bytes < 0 ? std::strerror((int)-bytes) : "lectura incompleta") << ")" << std::endl;
+            return false;
+        }
+        result.latencyUs[i] = std::chrono::duration<double, std::micro>(Clock::now() - issued[i]).count();
+        return true;
+    };
+
+    auto start = Clock::now();
+    if (ring == nullptr) {
+        for (size_t i = 0; i < n; ++i) {
+            issued[i] = Clock::now();
+            ssize_t bytes = pread(file, buffers.get(), block, (off_t)offsets[i]);
+            if (!finish(i, bytes < 0 ? -errno : bytes)) return false;
+        }
+    } else {
+        // Cada lectura en vuelo ocupa un hueco del buffer; user_data = índice << 32 | hueco
+        std::vector<unsigned> freeSlots;
+        for (unsigned s = depth; s-- > 0;) freeSlots.push_back(s);
+        size_t next = 0, done = 0;
+        while (done < n) {
+            while (next < n && !freeSlots.empty()) {
+                unsigned slot = freeSlots.back();
+                if (!ring->read(file, buffers.get() + slot * block, (unsigned)block, offsets[next],
+                                (uint64_t(next) << 32) | slot)) {
+                    break;
+                }
+                freeSlots.pop_back();
+                issued[next++] = Clock::now();
+            }
+            if (!ring->submit(1)) {
+                std::cerr << "Error: io_uring_enter fallo: " << std::strerror(errno) << std::endl;
+                return false;
+            }
+            uint64_t userData;
+            int bytes;
+            while (ring->complete(userData, bytes)) {
+                if (!finish(userData >> 32, bytes)) return false;
+                freeSlots.push_back(unsigned(userData & 0xffffffffu));
+                done++;
+            }
+        }
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return true;
+}
+
+// Reproduce FCFS, SCAN y C-SCAN contra 'path' (un archivo grande): cada
+// cilindro se asigna a una zona del archivo y cada visita a un cilindro lee
+// el siguiente bloque de su zona, así que los tres algoritmos leen los mismos
+// bloques y solo cambia el orden. Los cilindros que la ruta cruza sin
+// solicitud (la posición inicial y los extremos de SCAN/C-SCAN) no se leen
+int runReplay(const std::string& path, long long fileMB, const std::vector<int>& requests, int initialPos,
+              size_t block, unsigned depth) {
+    int file = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (file < 0) {
+        std::cerr << "Error: No se pudo abrir el archivo de prueba: " << path << std::endl;
+        return 1;
+    }
+    // Se rellena con datos reales (no un archivo disperso) hasta el tamaño
+    // pedido. Solo se agrega al final: lo que ya tenía el archivo no se toca
+    struct stat info;
+    if (fstat(file, &info) != 0) {
+        std::cerr << "Error: no se pudo consultar el archivo de prueba: " << std::strerror(errno) << std::endl;
+        close(file);
+        return 1;
+    }
+    const off_t target = off_t(fileMB) * (1 << 20);
+    if (fileMB > 0 && info.st_size < target) {
+        std::vector<char> fill(1 << 20, 'x');
+        for (off_t size = info.st_size; size < target;) {
+            size_t chunk = (size_t)std::min<off_t>(fill.size(), target - size);
+            ssize_t written = pwrite(file, fill.data(), chunk, size);
+            if (written <= 0) {
+                std::cerr << "Error: no se pudo crear el archivo de prueba: " << std::strerror(errno) << std::endl;
+                close(file);
+                return 1;
+            }
+            size += written;
+        }
+        if (fsync(file) != 0 || fstat(file, &info) != 0) {
+            std::cerr << "Error: no se pudo crear el archivo de prueba: " << std::strerror(errno) << std::endl;
+            close(file);
+            return 1;
+        }
+    }
+    close(file);
+
+    const long long cylinders = MAX_CYLINDER - MIN_CYLINDER + 1;
+    const uint64_t zone = uint64_t(info.st_size) / cylinders / block * block;
+    if (zone == 0) {
+        std::cerr << "Error: el archivo de prueba necesita al menos " << cylinders * block
+                  << " bytes (use --tamano-archivo MB)" << std::endl;
+        return 1;
+    }
+
+    bool direct = true;
+    file = open(path.c_str(), O_RDONLY | O_DIRECT);
+    if (file < 0) {
+        direct = false;
+        file = open(path.c_str(), O_RDONLY);
+        if (file < 0) {
+            std::cerr << "Error: No se pudo abrir el archivo de prueba: " << path << std::endl;
+            return 1;
+        }
+    }
+    IoUring uring(depth);
+    IoUring* ring = uring.ok() ? &uring : nullptr;
+
+    std::cout << "\nReproduccion con E/S real" << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+    std::cout << "Archivo: " << path << " (" << info.st_size / (1 << 20) << " MB) | Bloque: " << block
+              << " bytes | Zona por cilindro: " << zone / 1024 << " KB" << std::endl;
+    std::cout << "Motor: " << (ring != nullptr ? "io_uring" : "pread") << " | Profundidad: " << (ring != nullptr ? depth : 1)
+              << " | O_DIRECT: " << (direct ? "si" : "no (se descarta la cache antes de cada corrida)") << std::endl;
+    std::cout << "Solicitudes: " << requests.size() << " | Posicion inicial del cabezal: " << initialPos << std::endl;
+    std::cout << "------------------------------------" << std::endl;
+    std::cout << "Algoritmo | IOPS | MB/s | Latencia media (us) | p50 | p99 | max" << std::endl;
+
+    DiskScheduler scheduler;
+    std::vector<int> sorted = DiskScheduler::sortRequests(requests);
+    std::vector<long long> pending(cylinders);
+    std::vector<uint64_t> visits(cylinders);
+    for (const char* name : {"fcfs", "scan", "cscan"}) {
+        const AlgorithmEntry& a = *findAlgorithm(name);
+        PathStream stream = (scheduler.*a.stream)(initialPos, a.usesSorted ? sorted : requests);
+        std::vector<int> planned(stream.remaining());
+        stream.read(planned.data(), planned.size());
+
+        std::fill(pending.begin(), pending.end(), 0);
+        std::fill(visits.begin(), visits.end(), 0);
+        for (int c : requests) pending[c - MIN_CYLINDER]++;
+        std::vector<uint64_t> offsets;
+        offsets.reserve(requests.size());
+        for (size_t i = 1; i < planned.size(); ++i) {
+            int c = planned[i] - MIN_CYLINDER;
+            if (pending[c] == 0) continue;
+            pending[c]--;
+            offsets.push_back(c * zone + visits[c]++ % (zone / block) * block);
+        }
+
+        if (!direct) posix_fadvise(file, 0, 0, POSIX_FADV_DONTNEED);
+        ReplayResult r;
+        if (!replayReads(file, offsets, block, depth, ring, r)) {
+            close(file);
+            return 1;
+        }
+        double total = 0;
+        for (double l : r.latencyUs) total += l;
+        double maxLatency = *std::max_element(r.latencyUs.begin(), r.latencyUs.end());
+        std::cout << a.label << "    | " << std::fixed << std::setprecision(0) << r.reads / r.seconds << " | "
+                  << std::setprecision(2) << r.reads * block / r.seconds / (1 << 20) << " | " << total / r.reads << " | "
+                  << percentile(r.latencyUs, 0.50) << " | " << percentile(r.latencyUs, 0.99) << " | " << maxLatency
+                  << std::endl;
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    close(file);
+    return 0;
+}
+#endif
+
+// Micro-benchmark del kernel de movimiento: el ciclo escalar contra las
+// versiones SSE4.1 y AVX2 (las que soporte la CPU) de 10^4 a 10^8 elementos.
+// Cada medición recorre unos 2*10^8 elementos repitiendo la ruta
+void benchmarkMovementKernels() {
+    struct Variant {
+        const char* name;
+        MovementKernel kernel;
+        bool available;
+    };
+    std::vector<Variant> variants = {{"escalar", &movementScalar, true}};
+#ifdef DISK_SIMD_X86
+    __builtin_cpu_init();
+    variants.push_back({"sse4.1", &movementSSE41, (bool)__builtin_cpu_supports("sse4.1")});
+    variants.push_back({"avx2", &movementAVX2, (bool)__builtin_cpu_supports("avx2")});
+#endif
+
+    std::cout << "elementos; kernel; ns/elemento; GB/s; movimiento" << std::endl;
+    for (size_t n = 10000; n <= 100000000; n *= 10) {
+        std::vector<int> path(n);
+        for (size_t i = 0; i < n; ++i) path[i] = std::rand() % (MAX_CYLINDER + 1);
+        size_t reps = std::max<size_t>(1, 200000000 / n);
+
+        long long expected = movementScalar(path.data(), n);
+        for (const Variant& v : variants) {
+            if (!v.available) continue;
+            long long movement = 0;
+            auto start = std::chrono::steady_clock::now();
+            for (size_t r = 0; r < reps; ++r) {
+                movement = v.kernel(path.data(), n);
+                // Que no se salte repeticiones: una barrera del compilador con
+                // GCC/Clang y, en otros compiladores, una escritura volátil
+#ifdef __GNUC__
+                asm volatile("" : : "r"(movement) : "memory");
+#else
+                static volatile long long sink;
+                sink = movement;
+#endif
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            double elements = double(n) * reps;
+            std::cout << n << "; " << v.name << "; " << std::fixed << std::setprecision(3)
+                      << seconds * 1e9 / elements << "; " << std::setprecision(2)
+                      << elements * sizeof(int) / seconds / 1e9 << "; " << movement << std::endl;
+            std::cout.unsetf(std::ios::floatfield);
+            if (movement != expected) {
+                std::cerr << "Error: " << v.name << " dio " << movement << " y se esperaba " << expected << std::endl;
+            }
+        }
+    }
+}
+
+// Benchmark de planificación: cada algoritmo sobre cada distribución con
+// lotes de 10^4 a 10^7. El tiempo cubre ordenar el lote (si el algoritmo lo
+// necesita) y recorrer la ruta completa calculando el movimiento
+void benchmarkDistributions(int initialPos, uint64_t seed, const WorkloadParams& params) {
+    std::cout << "distribucion; solicitudes; algoritmo; movimiento; movimiento/solicitud; ns/solicitud" << std::endl;
+    const size_t CHUNK = 1 << 16;
+    std::vector<int> chunk(CHUNK + 1);
+    for (const DistributionEntry& dist : DISTRIBUTIONS) {
+        for (long long n = 10000; n <= 10000000; n *= 10) {
+            FastRandom rng(seed);
+            std::vector<int> requests = generateRequests(n, dist.distribution, rng, params);
+            for (const AlgorithmEntry& a : ALGORITHMS) {
+                DiskScheduler scheduler;
+                auto start = std::chrono::steady_clock::now();
+                std::vector<int> sorted;
+                if (a.usesSorted) sorted = DiskScheduler::sortRequests(requests);
+                PathStream path = (scheduler.*a.stream)(initialPos, a.usesSorted ? sorted : requests);
+                // Cada bloque lleva delante el último cilindro del anterior
+                long long movement = 0;
+                chunk[0] = initialPos;
+                size_t read;
+                while ((read = path.read(chunk.data() + 1, CHUNK)) > 0) {
+                    movement += movementKernel()(chunk.data(), read + 1);
+                    chunk[0] = chunk[read];
+                }
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                std::cout << dist.name << "; " << n << "; " << a.name << "; " << movement << "; " << std::fixed
+                          << std::setprecision(3) << double(movement) / n << "; " << seconds * 1e9 / n << std::endl;
+                std::cout.unsetf(std::ios::floatfield);
+            }
+        }
+    }
+}
+
+// Interpreta todo 'text' como un número; false si está vacío, sobra texto o
+// no cabe en el tipo
+template <typename T>
+bool parseNumber(const char* text, T& value) {
+    const char* end = text + std::strlen(text);
+    auto [p, ec] = std::from_chars(text, end, value);
+    return ec == std::errc() && p == end && text != end;
+}
+
+int main(int argc, char* argv[]) {
     int initialHeadPos;
 
-    // 1. Leer la posición inicial desde std::cin
-    std::cin >> initialHeadPos;
+    // Argumentos opcionales: cantidad de solicitudes y --solo-metricas
+    // (calcula el movimiento sin generar las rutas ni los archivos).
+    // --dinamico simula llegadas en el tiempo con --tasa (sol/s), --semilla
+    // y --plazo (ms, para DEADLINE). --arreglo K reparte el lote en K discos
+    // con franjas de --franja bloques y planifica cada uno con --algoritmo.
+    // --formato binario escribe las rutas en .bin en vez de .txt.
+    // --distribucion elige cómo se generan los cilindros (con --zipf, --racha
+    // y --secuencial; también en --dinamico y --arreglo) y
+    // --bench-distribuciones compara todos los algoritmos.
+    // --reproducir RUTA lee bloques reales de un archivo en el orden de cada
+    // algoritmo (--profundidad, --bloque y --tamano-archivo MB)
+    long long requestCount = REQUEST_COUNT;
+    bool metricsOnly = false;
+    bool binaryPaths = false;
+    bool benchDistributions = false;
+    Distribution distribution = Distribution::UNIFORM;
+    WorkloadParams workload;
+    bool seedGiven = false;
+    std::string replayPath;
+    long long replayFileMB = 0;
+    long long replayBlock = 4096;
+    long long replayDepth = 32;
+    bool dynamic = false;
+    double rate = 150;
+    uint64_t seed = 1;
+    double deadlineMs = 500;
+    DiskTimingModel model;
+    StripedArray array{0, 64};
+    const AlgorithmEntry* arrayAlgorithm = findAlgorithm("scan");
+    for (int a = 1; a < argc; ++a) {
+        std::string arg = argv[a];
+        if (arg == "--solo-metricas") {
+            metricsOnly = true;
+            continue;
+        }
+        if (arg == "--dinamico") {
+            dynamic = true;
+            continue;
+        }
+        if (arg == "--semilla" && a + 1 < argc) {
+            if (!parseNumber(argv[++a], seed)) {
+                std::cerr << "Error: valor no valido para " << arg << std::endl;
+                return 1;
+            }
+            seedGiven = true;
+            continue;
+        }
+        if ((arg == "--tasa" || arg == "--plazo" || arg == "--rpm" ||
+             arg == "--busqueda-base" || arg == "--busqueda-raiz" || arg == "--transferencia") && a + 1 < argc) {
+            double value = 0;
+            if (!parseNumber(argv[++a], value)) value = -1; // Se rechaza abajo
+            if (arg == "--tasa") rate = value;
+            else if (arg == "--plazo") deadlineMs = value;
+            else if (arg == "--rpm") model.rpm = value;
+            else if (arg == "--busqueda-base") model.seekBase = value;
+            else if (arg == "--busqueda-raiz") model.seekSqrt = value;
+            else model.transfer = value;
+            if (!(value >= 0) || (arg == "--tasa" && value <= 0) || (arg == "--rpm" && value <= 0)) {
+                std::cerr << "Error: valor no valido para " << arg << std::endl;
+                return 1;
+            }
+            continue;
+        }
+        if ((arg == "--arreglo" || arg == "--franja") && a + 1 < argc) {
+            int value = 0;
+            if (!parseNumber(argv[++a], value)) value = -1; // Se rechaza abajo
+            if (arg == "--arreglo") array.disks = value;
+            else array.stripe = value;
+            if (value < 1 || array.stripe > MAX_CYLINDER - MIN_CYLINDER + 1 ||
+                (arg == "--arreglo" && value > 1024)) {
+                std::cerr << "Error: valor no valido para " << arg << std::endl;
+                return 1;
+            }
+            continue;
+        }
+        if (arg == "--distribucion" && a + 1 < argc) {
+            std::string name = argv[++a];
+            auto it = std::find_if(std::begin(DISTRIBUTIONS), std::end(DISTRIBUTIONS),
+                                   [&](const DistributionEntry& d) { return name == d.name; });
+            if (it == std::end(DISTRIBUTIONS)) {
+                std::cerr << "Error: distribucion desconocida (uniforme, zipf, secuencial o mixta)" << std::endl;
+                return 1;
+            }
+            distribution = it->distribution;
+            continue;
+        }
+        if ((arg == "--zipf" || arg == "--racha" || arg == "--secuencial") && a + 1 < argc) {
+            double value = 0;
+            if (!parseNumber(argv[++a], value)) value = -1; // Se rechaza abajo
+            if (!(value >= 0) || (arg == "--racha" && value < 1) || (arg == "--secuencial" && value > 1)) {
+                std::cerr << "Error: valor no valido para " << arg << std::endl;
+                return 1;
+            }
+            if (arg == "--zipf") workload.zipfExponent = value;
+            else if (arg == "--racha") workload.meanRun = value;
+            else workload.sequentialShare = value;
+            continue;
+        }
+        if (arg == "--reproducir" && a + 1 < argc) {
+            replayPath = argv[++a];
+            continue;
+        }
+        if ((arg == "--profundidad" || arg == "--bloque" || arg == "--tamano-archivo") && a + 1 < argc) {
+            long long value = 0;
+            if (!parseNumber(argv[++a], value)) value = -1; // Se rechaza abajo
+            if (arg == "--profundidad") replayDepth = value;
+            else if (arg == "--bloque") replayBlock = value;
+            else replayFileMB = value;
+            if (replayDepth < 1 || replayDepth > 4096 || replayBlock < 512 || replayBlock > (1 << 24) ||
+                replayBlock % 512 != 0 || replayFileMB < 0) {
+                std::cerr << "Error: valor no valido para " << arg << std::endl;
+                return 1;
+            }
+            continue;
+        }
+        if (arg == "--bench-distribuciones") {
+            benchDistributions = true;
+            continue;
+        }
+        if (arg == "--formato" && a + 1 < argc) {
+            std::string format = argv[++a];
+            if (format != "texto" && format != "binario") {
+                std::cerr << "Error: formato desconocido (texto o binario)" << std::endl;
+                return 1;
+            }
+            binaryPaths = format == "binario";
+            continue;
+        }
+        if (arg == "--algoritmo" && a + 1 < argc) {
+            arrayAlgorithm = findAlgorithm(argv[++a]);
+            if (arrayAlgorithm == nullptr) {
+                std::cerr << "Error: algoritmo desconocido (fcfs, scan, cscan, sstf, look o clook)" << std::endl;
+                return 1;
+            }
+            continue;
+        }
+        if (arg == "--bench-movimiento") {
+            benchmarkMovementKernels();
+            return 0;
+        }
+        if (arg.rfind("--", 0) == 0) {
+            std::cerr << "Error: opcion desconocida " << arg << std::endl;
+            return 1;
+        }
+        if (!parseNumber(argv[a], requestCount) || requestCount < 1 || requestCount > MAX_REQUEST_COUNT) {
+            std::cerr << "Error: la cantidad de solicitudes debe estar entre 1 y "
+                      << MAX_REQUEST_COUNT << std::endl;
+            return 1;
+        }
+    }
+
+    // 1. Leer la posición inicial desde std::cin (tiene que ser un cilindro del disco)
+    if (!(std::cin >> initialHeadPos) || initialHeadPos < MIN_CYLINDER || initialHeadPos > MAX_CYLINDER) {
+        std::cerr << "Error: la posicion inicial debe ser un cilindro entre " << MIN_CYLINDER << " y "
+                  << MAX_CYLINDER << std::endl;
+        return 1;
+    }
+
+    // Sin --semilla cada corrida usa la hora como semilla, en todos los modos
+    if (!seedGiven) seed = static_cast<uint64_t>(std::time(nullptr));
+
+    if (dynamic) {
+        runDynamicSimulation(initialHeadPos, requestCount, rate, seed, distribution, workload, deadlineMs, model);
+        return 0;
+    }
+    if (benchDistributions) {
+        benchmarkDistributions(initialHeadPos, seed, workload);
+        return 0;
+    }
+    if (array.disks > 0) {
+        runArraySimulation(array, *arrayAlgorithm, initialHeadPos, requestCount, seed, distribution, workload, model);
+        return 0;
+    }
     
     // 2. Generar solicitudes
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-    std::vector<int> requests;
-    for (int i = 0; i < REQUEST_COUNT; ++i) {
-        requests.push_back(std::rand() % (MAX_CYLINDER + 1));
+    FastRandom rng(seed);
+    std::vector<int> requests = generateRequests(requestCount, distribution, rng, workload);
+
+    if (!replayPath.empty()) {
+#ifdef DISK_REPLAY_LINUX
+        return runReplay(replayPath, replayFileMB, requests, initialHeadPos, replayBlock, replayDepth);
+#else
+        std::cerr << "Error: --reproducir solo esta disponible en Linux" << std::endl;
+        return 1;
+#endif
     }
 
-    // 3. Crear instancia y ejecutar
+    // 3. Crear instancia y ejecutar. El lote se ordena una sola vez (SSTF
+    // lo necesita siempre). El movimiento sale de las formas cerradas y las
+    // rutas se escriben bajo demanda, sin guardarlas completas en memoria
     DiskScheduler scheduler;
+    std::vector<int> sorted = DiskScheduler::sortRequests(requests);
+    // Sin rutas basta el resumen de una pasada; con el lote ordenado sale en O(log n)
+    RequestSummary summary = metricsOnly ? DiskScheduler::summarize(initialHeadPos, requests)
+                                         : DiskScheduler::summarizeSorted(initialHeadPos, sorted);
+
+    const long long movements[] = {
+        scheduler.movementFCFS(initialHeadPos, requests),
+        scheduler.movementSCAN(summary),
+        scheduler.movementCSCAN(summary),
+        scheduler.movementSSTF(initialHeadPos, sorted),
+        scheduler.movementLOOK(summary),
+        scheduler.movementCLOOK(summary),
+    };
 
-    SchedulingResult fcfs = scheduler.calculateFCFS(initialHeadPos, requests);
-    SchedulingResult scan = scheduler.calculateSCAN(initialHeadPos, requests);
-    SchedulingResult cscan = scheduler.calculateCSCAN(initialHeadPos, requests);
+    // Rutas completas (a archivos .txt, o .bin con --formato binario)
+    if (!metricsOnly) {
+        for (const AlgorithmEntry& a : ALGORITHMS) {
+            PathStream path = (scheduler.*a.stream)(initialHeadPos, a.usesSorted ? sorted : requests);
+            if (binaryPaths) {
+                std::string filename = a.filename;
+                savePathToBinaryFile(filename.replace(filename.size() - 4, 4, ".bin"), path);
+            } else {
+                savePathToFile(a.filename, path);
+            }
+        }
+    }
 
     // 4. Imprimir resultados en formato de texto plano para Python
 
     std::cout << "\nSimulador de Planificacion de Disco" << std::endl;
     std::cout << "------------------------------------" << std::endl;
     std::cout << "Cilindros: " << MIN_CYLINDER << " a " << MAX_CYLINDER << std::endl;
-    std::cout << "Solicitudes generadas: " << REQUEST_COUNT << std::endl;
+    std::cout << "Solicitudes generadas: " << requestCount << std::endl;
     std::cout << "Posicion inicial del cabezal: " << initialHeadPos << std::endl;
     std::cout << "------------------------------------" << std::endl;
 
-    // FCFS
-    std::cout << "FCFS   | Movimiento Total: " << fcfs.movement << std::endl;
-
-    // SCAN
-    std::cout << "SCAN   | Movimiento Total: " << scan.movement << std::endl;
-
-    // C-SCAN
-    std::cout << "C-SCAN | Movimiento Total: " << cscan.movement << std::endl;
-    
-
-    // Rutas completas (a archivos .txt)
-    savePathToFile("fcfs_path.txt", fcfs.path);
-    savePathToFile("scan_path.txt", scan.path);
-    savePathToFile("cscan_path.txt", cscan.path);
+    for (size_t i = 0; i < std::size(ALGORITHMS); ++i) {
+        std::cout << ALGORITHMS[i].label << " | Movimiento Total: " << movements[i] << std::endl;
+    }
 
     return 0;
 }
\ No newline at end of file
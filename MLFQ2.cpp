@@ -1,53 +1,179 @@
 #include <iostream>
 #include <fstream>
-#include <queue>
 #include <vector>
 #include <sstream>
 #include <algorithm>
 #include <string>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <string_view>
+#include <thread>
+#include <queue>
+#include <iomanip>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <chrono>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
 using namespace std;
 
-class proceso {
+// Indice que marca "ningun proceso" en las colas
+const uint32_t NINGUNO = UINT32_MAX;
+
+// Tabla de procesos organizada como estructura de arreglos: cada campo vive en
+// su propio vector y un proceso se identifica por su indice (32 bits). La
+// tabla guarda solo los datos de entrada, que no cambian durante una
+// simulación, así que varias simulaciones pueden compartirla
+class TablaProcesos {
 public:
-    string etiqueta;  // Etiqueta del proceso
-    int arrival_time; // Arrival Time
-    int burst_time; // Burst Time
-    int priority;   // Prioridad del proceso
-    int ComTim;     // Completion Time
-    int TuArTi;     // Turnaround Time
-    int WaiTim;     // Waiting Time
-    int ResTim;     // Response Time
-    int tiempoRestante; // Tiempo restante para que termine un proceso
-    int nivel;          // Nivel de la cola en MLFQ
-    bool primeraVez;    // Indica si es la primera vez que se ejecuta el proceso
-    int cola;           // Cola a la que pertenece el proceso
-
-    // Constructor de la clase proceso
-    proceso(string et, int BT, int AT, int q, int p)
-        : etiqueta(et), burst_time(BT), arrival_time(AT), priority(p),
-          ComTim(0), TuArTi(0), WaiTim(0), ResTim(0), cola(q),
-          tiempoRestante(BT), nivel(0), primeraVez(true) {}
+    vector<string> etiqueta;        // Etiqueta del proceso
+    vector<long long> arrival_time; // Arrival Time
+    vector<long long> burst_time;   // Burst Time
+    vector<int> priority;           // Prioridad del proceso
+    vector<int> cola;               // Cola a la que pertenece el proceso
+
+    // Número de procesos en la tabla
+    uint32_t size() const {
+        return etiqueta.size();
+    }
+
+    // Método para reservar espacio para n procesos
+    void reservar(size_t n) {
+        etiqueta.reserve(n); arrival_time.reserve(n); burst_time.reserve(n);
+        priority.reserve(n); cola.reserve(n);
+    }
+
+    // Método para añadir un proceso a la tabla
+    void agregar(string et, long long BT, long long AT, int q, int p) {
+        etiqueta.push_back(move(et));
+        burst_time.push_back(BT);
+        arrival_time.push_back(AT);
+        cola.push_back(q);
+        priority.push_back(p);
+    }
+
+    // Método para añadir al final todos los procesos de otra tabla
+    void anexar(TablaProcesos&& otra) {
+        mover(etiqueta, otra.etiqueta); mover(arrival_time, otra.arrival_time);
+        mover(burst_time, otra.burst_time); mover(priority, otra.priority);
+        mover(cola, otra.cola);
+    }
+
+    // Reordena físicamente la tabla por tiempo de llegada, de modo que los
+    // índices sigan el orden en que los procesos entran al sistema. El orden
+    // es estable: a igual llegada manda el orden del archivo, como en el modo
+    // en línea
+    void ordenarPorLlegada() {
+        vector<uint32_t> orden(size());
+        for (uint32_t i = 0; i < size(); i++) orden[i] = i;
+        stable_sort(orden.begin(), orden.end(),
+             [this](uint32_t a, uint32_t b) {
+                 return arrival_time[a] < arrival_time[b];
+             });
+        permutar(etiqueta, orden); permutar(arrival_time, orden);
+        permutar(burst_time, orden); permutar(priority, orden);
+        permutar(cola, orden);
+    }
+
+private:
+    template <typename T>
+    static void mover(vector<T>& destino, vector<T>& origen) {
+        destino.insert(destino.end(), make_move_iterator(origen.begin()),
+                       make_move_iterator(origen.end()));
+        origen.clear();
+    }
+
+    template <typename T>
+    static void permutar(vector<T>& v, const vector<uint32_t>& orden) {
+        vector<T> nuevo;
+        nuevo.reserve(v.size());
+        for (uint32_t i : orden) nuevo.push_back(move(v[i]));
+        v.swap(nuevo);
+    }
+};
+
+// Estado de una simulación sobre una tabla de procesos, también como
+// estructura de arreglos indexada igual que la tabla
+class EstadoProcesos {
+public:
+    // Campos calientes (se modifican en cada quantum)
+    vector<long long> tiempoRestante; // Tiempo restante para que termine un proceso
+    vector<int> nivel;                // Nivel de la cola en MLFQ
+    vector<char> primeraVez;          // Indica si es la primera vez que se ejecuta el proceso
+
+    // Resultados (TAT y WT se derivan de estos al imprimir)
+    vector<long long> ComTim; // Completion Time
+    vector<long long> ResTim; // Response Time
+
+    // Método para dejar el estado listo para simular la tabla desde cero
+    void reiniciar(const TablaProcesos& t) {
+        tiempoRestante.assign(t.burst_time.begin(), t.burst_time.end());
+        nivel.assign(t.size(), 0);
+        primeraVez.assign(t.size(), true);
+        ComTim.assign(t.size(), 0);
+        ResTim.assign(t.size(), 0);
+    }
+
+    // Método para dejar listo el lugar p para un proceso nuevo (crece si hace falta)
+    void iniciar(uint32_t p, long long BT) {
+        if (p >= tiempoRestante.size()) {
+            tiempoRestante.resize(p + 1); nivel.resize(p + 1); primeraVez.resize(p + 1);
+            ComTim.resize(p + 1); ResTim.resize(p + 1);
+        }
+        tiempoRestante[p] = BT;
+        nivel[p] = 0;
+        primeraVez[p] = true;
+        ComTim[p] = 0;
+        ResTim[p] = 0;
+    }
 };
 
+// Políticas de planificación que puede usar cada nivel
+enum class Politica { RR, FCFS, SJF, SRTF, PRIORIDAD };
+
+// Convierte el tipo de cola ("RR", "FCFS", "SJF", "SRTF", "PR") a su política.
+// Devuelve false si el tipo no existe
+bool leerPolitica(const string& tipo, Politica& pol) {
+    if (tipo == "RR") pol = Politica::RR;
+    else if (tipo == "FCFS") pol = Politica::FCFS;
+    else if (tipo == "SJF") pol = Politica::SJF;
+    else if (tipo == "SRTF") pol = Politica::SRTF;
+    else if (tipo == "PR" || tipo == "PRIORIDAD") pol = Politica::PRIORIDAD;
+    else return false;
+    return true;
+}
+
 class Cola {
 public:
-    queue<proceso> procesos; // Cola de procesos
-    int quantum;         // Quantum de tiempo para la cola
+    uint32_t primero;  // Primer proceso (FIFO) o raíz del montículo (NINGUNO si está vacía)
+    uint32_t ultimo;   // Último proceso de la cola (solo FIFO)
+    int quantum;       // Quantum de tiempo para la cola (0 = sin límite)
     string tipo;       // Tipo de la cola (RR, FCFS, etc.)
-    int nivel;        // Nivel de la cola
+    Politica politica; // Política correspondiente a tipo
+    int nivel;         // Nivel de la cola
+    long long ultimoServicio; // Último despacho desde la cola (o cuándo dejó de estar vacía)
+    uint32_t tam;      // Procesos en la cola
 
     // Constructor de la clase Cola
-    Cola(int lvl, string pol, int tq = 0)
-        : nivel(lvl), tipo(pol), quantum(tq) {}
-
-    // Método para añadir un proceso a la cola
-    void add_process(const proceso& p) {
-        procesos.push(p);
-    }
+    Cola(int lvl, string tp, Politica pol, int tq = 0)
+        : primero(NINGUNO), ultimo(NINGUNO), quantum(tq), tipo(tp), politica(pol), nivel(lvl),
+          ultimoServicio(0), tam(0) {}
 
     // Método para verificar si la cola está vacía
     bool is_empty() const {
-        return procesos.empty();
+        return primero == NINGUNO;
+    }
+
+    // RR y FCFS atienden en orden de llegada; el resto elige por clave
+    bool es_monticulo() const {
+        return politica != Politica::RR && politica != Politica::FCFS;
     }
 };
 
@@ -55,185 +181,2216 @@ class Scheduler {
 public:
     // Vector de tipos de planificacion (colas)
     vector<Cola> queues;
+    // Enlace de cada proceso al siguiente de su misma cola (o a su hermano en
+    // el montículo). Las colas son estructuras intrusivas de índices: encolar
+    // y desencolar no reservan memoria
+    vector<uint32_t> siguiente;
+    // Primer hijo de cada proceso en un montículo de emparejamiento (pairing heap)
+    vector<uint32_t> hijo;
+    // Clave de orden del proceso en su montículo (menor sale primero)
+    vector<long long> clave;
+    // Tiempo en que el proceso entró a su cola actual (para el envejecimiento)
+    vector<long long> encolado;
 
     // Constructor de la clase Scheduler
     Scheduler() {};
 
-    // Método para añadir una nueva cola al scheduler
-    void add_queue(int level, const string& policy, int time_quantum) {
-        queues.emplace_back(level, policy, time_quantum);
+    // Método para añadir una nueva cola al scheduler; false si la política no existe
+    bool add_queue(int level, const string& policy, int time_quantum) {
+        Politica pol;
+        if (!leerPolitica(policy, pol)) return false;
+        queues.emplace_back(level, policy, pol, time_quantum);
+        return true;
+    }
+
+    // Método para preparar los enlaces para los procesos de la tabla
+    void preparar(const TablaProcesos& t, const EstadoProcesos& e) {
+        tabla = &t;
+        estado = &e;
+        siguiente.assign(t.size(), NINGUNO);
+        hijo.assign(t.size(), NINGUNO);
+        clave.assign(t.size(), 0);
+        encolado.assign(t.size(), 0);
+    }
+
+    // Método para agrandar los enlaces cuando la tabla crece durante la simulación
+    void crecer(uint32_t n) {
+        if (n <= siguiente.size()) return;
+        siguiente.resize(n, NINGUNO);
+        hijo.resize(n, NINGUNO);
+        clave.resize(n, 0);
+        encolado.resize(n, 0);
+    }
+
+    // Método para añadir un proceso a la cola de un nivel en el tiempo ahora
+    void add_process(int lvl, uint32_t p, long long ahora) {
+        Cola& c = queues[lvl];
+        if (c.is_empty()) c.ultimoServicio = ahora;
+        c.tam++;
+        encolado[p] = ahora;
+        siguiente[p] = NINGUNO;
+        if (c.es_monticulo()) {
+            // Montículo: inserción O(1) uniendo el proceso con la raíz
+            hijo[p] = NINGUNO;
+            clave[p] = claveDe(c.politica, p);
+            c.primero = unir(c.primero, p);
+            return;
+        }
+        // FIFO: al final de la lista
+        if (c.is_empty()) c.primero = p;
+        else siguiente[c.ultimo] = p;
+        c.ultimo = p;
+    }
+
+    // Método para sacar el siguiente proceso a ejecutar de un nivel
+    uint32_t pop_process(int lvl, long long ahora) {
+        Cola& c = queues[lvl];
+        uint32_t p = c.primero;
+        c.ultimoServicio = ahora;
+        c.tam--;
+        if (c.es_monticulo()) {
+            // Montículo: O(log n) amortizado uniendo los hijos de la raíz
+            c.primero = unirHijos(hijo[p]);
+            hijo[p] = NINGUNO;
+            return p;
+        }
+        c.primero = siguiente[p];
+        if (c.primero == NINGUNO) c.ultimo = NINGUNO;
+        return p;
+    }
+
+    // Método para mover todos los procesos de la cola origen a la cola destino.
+    // Entre colas FIFO se empalman las listas y entre montículos de la misma
+    // política se unen las raíces, ambos en O(1) sin importar cuántos procesos
+    // haya; si las estructuras no son compatibles se pasan uno a uno
+    void empalmar_cola(int origen, int destino, long long ahora) {
+        Cola& o = queues[origen];
+        Cola& d = queues[destino];
+        if (o.is_empty()) return;
+        if (d.is_empty()) d.ultimoServicio = ahora;
+        if (!o.es_monticulo() && !d.es_monticulo()) {
+            if (d.is_empty()) d.primero = o.primero;
+            else siguiente[d.ultimo] = o.primero;
+            d.ultimo = o.ultimo;
+        } else if (o.politica == d.politica) {
+            d.primero = unir(d.primero, o.primero);
+        } else {
+            while (!o.is_empty()) add_process(destino, pop_process(origen, ahora), ahora);
+        }
+        d.tam += o.tam;
+        o.primero = o.ultimo = NINGUNO;
+        o.tam = 0;
+    }
+
+    // Método de envejecimiento: sube un nivel a los procesos que llevan al
+    // menos 'umbral' esperando en su cola. En una cola FIFO los que esperan
+    // más están al principio, así que se corta ese prefijo y se empalma al
+    // final del nivel superior. Un montículo no guarda el orden de llegada:
+    // sube completo cuando lleva 'umbral' sin que se despache nada de él.
+    // Solo se revisan las colas [base, base + niveles) (la jerarquía de un
+    // núcleo). Devuelve cuántos procesos subieron y deja en nivelMin el nivel
+    // más alto que recibió alguno
+    long long envejecer(long long ahora, long long umbral, int& nivelMin, int base, int niveles) {
+        long long subidos = 0;
+        for (int lvl = base + 1; lvl < base + niveles; lvl++) {
+            Cola& c = queues[lvl];
+            if (c.is_empty()) continue;
+            if (c.es_monticulo()) {
+                if (ahora - c.ultimoServicio < umbral) continue;
+                subidos += c.tam; // Suben todos: se cuentan antes de empalmar
+                empalmar_cola(lvl, lvl - 1, ahora);
+                nivelMin = min(nivelMin, lvl - 1);
+                continue;
+            }
+            // Recorrer el prefijo envejecido reiniciando su tiempo de espera
+            uint32_t p = c.primero;
+            uint32_t finPrefijo = NINGUNO;
+            uint32_t largo = 0;
+            while (p != NINGUNO && ahora - encolado[p] >= umbral) {
+                encolado[p] = ahora;
+                finPrefijo = p;
+                p = siguiente[p];
+                largo++;
+            }
+            if (finPrefijo == NINGUNO) continue;
+            subidos += largo;
+            c.tam -= largo;
+            uint32_t inicioPrefijo = c.primero;
+            c.primero = p;
+            if (p == NINGUNO) c.ultimo = NINGUNO;
+            siguiente[finPrefijo] = NINGUNO;
+
+            Cola& d = queues[lvl - 1];
+            if (d.es_monticulo()) {
+                for (uint32_t q = inicioPrefijo; q != NINGUNO;) {
+                    uint32_t sig = siguiente[q];
+                    add_process(lvl - 1, q, ahora);
+                    q = sig;
+                }
+            } else {
+                if (d.is_empty()) {
+                    d.primero = inicioPrefijo;
+                    d.ultimoServicio = ahora;
+                } else {
+                    siguiente[d.ultimo] = inicioPrefijo;
+                }
+                d.ultimo = finPrefijo;
+                d.tam += largo;
+            }
+            nivelMin = min(nivelMin, lvl - 1);
+        }
+        return subidos;
+    }
+
+private:
+    const TablaProcesos* tabla = nullptr;
+    const EstadoProcesos* estado = nullptr;
+
+    // Clave con la que la política ordena al proceso
+    long long claveDe(Politica pol, uint32_t p) const {
+        switch (pol) {
+            case Politica::SJF:       return tabla->burst_time[p];
+            case Politica::SRTF:      return estado->tiempoRestante[p];
+            case Politica::PRIORIDAD: return -tabla->priority[p]; // 5 > 1
+            default:                  return 0;
+        }
+    }
+
+    // ¿Debe p salir antes que q? A igual clave gana el que llegó antes
+    bool antes(uint32_t p, uint32_t q) const {
+        if (clave[p] != clave[q]) return clave[p] < clave[q];
+        if (tabla->arrival_time[p] != tabla->arrival_time[q]) {
+            return tabla->arrival_time[p] < tabla->arrival_time[q];
+        }
+        return p < q;
+    }
+
+    // Une dos montículos: la raíz perdedora pasa a ser el primer hijo de la ganadora
+    uint32_t unir(uint32_t a, uint32_t b) {
+        if (a == NINGUNO) return b;
+        if (b == NINGUNO) return a;
+        if (antes(b, a)) swap(a, b);
+        siguiente[b] = hijo[a];
+        hijo[a] = b;
+        return a;
+    }
+
+    // Une la lista de hermanos h en dos pasadas: primero por parejas de
+    // izquierda a derecha y luego acumulando de derecha a izquierda
+    uint32_t unirHijos(uint32_t h) {
+        uint32_t pares = NINGUNO; // Parejas ya unidas, en orden inverso
+        while (h != NINGUNO) {
+            uint32_t a = h;
+            uint32_t b = siguiente[a];
+            h = (b == NINGUNO) ? NINGUNO : siguiente[b];
+            siguiente[a] = NINGUNO;
+            if (b != NINGUNO) siguiente[b] = NINGUNO;
+            uint32_t u = unir(a, b);
+            siguiente[u] = pares;
+            pares = u;
+        }
+        uint32_t raiz = NINGUNO;
+        while (pares != NINGUNO) {
+            uint32_t sig = siguiente[pares];
+            siguiente[pares] = NINGUNO;
+            raiz = unir(raiz, pares);
+            pares = sig;
+        }
+        return raiz;
+    }
+};
+
+// Promedios de las métricas de los procesos completados
+struct Promedios {
+    double CT = 0, TAT = 0, WT = 0, RT = 0;
+};
+
+// Escritura y lectura binaria (orden de bytes de la máquina) para los puntos
+// de control. Los vectores van precedidos de su largo
+template <typename T>
+void escribirBin(ostream& out, const T& v) {
+    out.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+template <typename T>
+void escribirBin(ostream& out, const vector<T>& v) {
+    escribirBin(out, (uint64_t)v.size());
+    out.write(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(T));
+}
+template <typename T>
+bool leerBin(istream& in, T& v) {
+    return (bool)in.read(reinterpret_cast<char*>(&v), sizeof(T));
+}
+template <typename T>
+bool leerBin(istream& in, vector<T>& v, uint64_t maximo) {
+    uint64_t n = 0;
+    if (!leerBin(in, n) || n > maximo) return false;
+    v.resize(n);
+    return (bool)in.read(reinterpret_cast<char*>(v.data()), n * sizeof(T));
+}
+
+// Histograma de tamaño fijo al estilo HDR: los valores menores que 2^BITS_SUB
+// se guardan exactos y los demás en 2^BITS_SUB cubetas por cada potencia de
+// dos, con error relativo menor a 1%. Ocupa lo mismo con 10 procesos que
+// con 10^9, así que los percentiles no necesitan guardar cada valor
+class Histograma {
+public:
+    Histograma() : cubetas(SUB + (63 - BITS_SUB) * SUB, 0) {}
+
+    // Método para registrar un valor (los negativos cuentan como 0)
+    void registrar(long long v) {
+        if (v < 0) v = 0;
+        cubetas[indice(v)]++;
+        total++;
+        suma += v;
+        if (v > maximo) maximo = v;
+    }
+
+    // Valor bajo el cual queda la fracción q (0..1) de los registros
+    long long percentil(double q) const {
+        if (total == 0) return 0;
+        long long rango = max(1LL, (long long)ceil(q * total));
+        long long acumulado = 0;
+        for (size_t i = 0; i < cubetas.size(); i++) {
+            acumulado += cubetas[i];
+            if (acumulado >= rango) return min(limiteSuperior(i), maximo);
+        }
+        return maximo;
+    }
+
+    long long cantidad() const { return total; }
+    long long max_valor() const { return maximo; }
+    double promedio() const { return total ? suma / total : 0; }
+
+    // Métodos para guardar y recuperar el histograma en un punto de control
+    void guardar(ostream& out) const {
+        escribirBin(out, cubetas);
+        escribirBin(out, total);
+        escribirBin(out, maximo);
+        escribirBin(out, suma);
+    }
+    bool cargar(istream& in) {
+        size_t tam = cubetas.size();
+        return leerBin(in, cubetas, tam) && cubetas.size() == tam && leerBin(in, total) &&
+               leerBin(in, maximo) && leerBin(in, suma);
+    }
+
+private:
+    static const int BITS_SUB = 7;           // 128 sub-cubetas por potencia de dos
+    static const long long SUB = 1LL << BITS_SUB;
+
+    vector<long long> cubetas;
+    long long total = 0;
+    long long maximo = 0;
+    double suma = 0;
+
+    static size_t indice(long long v) {
+        if (v < SUB) return v;
+        int e = 63 - __builtin_clzll(v);     // Posición del bit más alto (>= BITS_SUB)
+        int corrimiento = e - BITS_SUB;
+        return SUB + (size_t)(e - BITS_SUB) * SUB + ((v >> corrimiento) - SUB);
+    }
+
+    static long long limiteSuperior(size_t i) {
+        if (i < (size_t)SUB) return i;
+        int corrimiento = (i - SUB) / SUB;
+        long long sub = (i - SUB) % SUB;
+        return ((SUB + sub + 1) << corrimiento) - 1;
+    }
+};
+
+// Métricas de los procesos completados, acumuladas a medida que terminan
+struct Metricas {
+    Histograma CT, TAT, WT, RT;
+
+    // Método para registrar un proceso completado
+    void registrar(const TablaProcesos& t, const EstadoProcesos& e, uint32_t p) {
+        long long tat = e.ComTim[p] - t.arrival_time[p];
+        CT.registrar(e.ComTim[p]);
+        TAT.registrar(tat);
+        WT.registrar(tat - t.burst_time[p]);
+        RT.registrar(e.ResTim[p]);
+    }
+
+    void guardar(ostream& out) const {
+        CT.guardar(out); TAT.guardar(out); WT.guardar(out); RT.guardar(out);
+    }
+    bool cargar(istream& in) {
+        return CT.cargar(in) && TAT.cargar(in) && WT.cargar(in) && RT.cargar(in);
+    }
+
+    Promedios promedios() const {
+        Promedios avgs;
+        avgs.CT = CT.promedio(); avgs.TAT = TAT.promedio();
+        avgs.WT = WT.promedio(); avgs.RT = RT.promedio();
+        return avgs;
     }
 };
 
-// Funcion para imprimir los resultados del WT, CT, TAT, RT
-void printResultados(vector<proceso>& resp) {
+// Funcion para escribir la fila de un proceso completado
+void escribirFila(ostream& out, const TablaProcesos& t, const EstadoProcesos& e, uint32_t p) {
+    long long tat = e.ComTim[p] - t.arrival_time[p];
+    out << t.etiqueta[p] << ";"
+        << t.burst_time[p] << ";"
+        << t.arrival_time[p] << ";"
+        << t.cola[p] << ";"
+        << t.priority[p] << ";"
+        << tat - t.burst_time[p] << ";"
+        << e.ComTim[p] << ";"
+        << e.ResTim[p] << ";"
+        << tat << "\n";
+}
+
+// Funcion para escribir los promedios y los percentiles de cada métrica
+void escribirResumen(ostream& out, const Metricas& metricas) {
+    Promedios avgs = metricas.promedios();
+    out << "WT=" << avgs.WT
+        << "; CT=" << avgs.CT
+        << "; RT=" << avgs.RT
+        << "; TAT=" << avgs.TAT << ";\n";
+
+    out << "# metrica; p50; p95; p99; max\n";
+    const pair<const char*, const Histograma*> hists[] = {
+        {"WT", &metricas.WT}, {"CT", &metricas.CT}, {"RT", &metricas.RT}, {"TAT", &metricas.TAT}};
+    for (auto& [nombre, h] : hists) {
+        out << nombre << ";" << h->percentil(0.50) << ";" << h->percentil(0.95) << ";"
+            << h->percentil(0.99) << ";" << h->max_valor() << "\n";
+    }
+}
+
+// Funcion para imprimir los resultados del WT, CT, TAT, RT. Las filas por
+// proceso salen de resp (vacío si se pidió --sin-detalle); los promedios y
+// percentiles salen de las métricas acumuladas
+void printResultados(const TablaProcesos& t, const EstadoProcesos& e, vector<uint32_t>& resp,
+                     const Metricas& metricas) {
 
     string filename = "salida_MLFQ.txt";
     // Ordenar por etiqueta para salida ordenada
     sort(resp.begin(), resp.end(),
-        [](proceso &a, proceso &b) {
-            return a.etiqueta < b.etiqueta;
+        [&t](uint32_t a, uint32_t b) {
+            return t.etiqueta[a] < t.etiqueta[b];
         });
 
-    int proc = resp.size();
-    vector<double> avgs(4, 0);
-
-    // Imprimir resultados
-    for (auto& p : resp) {
-        avgs[0] += p.ComTim;
-        avgs[1] += p.TuArTi;
-        avgs[2] += p.WaiTim;
-        avgs[3] += p.ResTim;
-    }
-    for (int i = 0; i < 4; i++) avgs[i] /= proc;
-
     ofstream out(filename);
     if (!out.is_open()) {
         cerr << "Error al abrir archivo de salida\n";
         return;
     }
-   
+
     // Guardar resultados en archivo
 
     out << "# archivo: " << filename << "\n";
-    out << "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n";
+    if (!resp.empty()) out << "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n";
+
+    for (uint32_t p : resp) escribirFila(out, t, e, p);
+    escribirResumen(out, metricas);
+
+    out.close();
+}
 
-    for (auto& p : resp) {
-        out << p.etiqueta << ";"
-            << p.burst_time << ";"
-            << p.arrival_time << ";"
-            << p.cola << ";"   
-            << p.priority << ";"
-            << p.WaiTim << ";"
-            << p.ComTim << ";"
-            << p.ResTim << ";"
-            << p.TuArTi << "\n";
+struct Instrumentacion;
+
+// Opciones de la simulación MLFQ
+struct OpcionesMLFQ {
+    bool preemptivo = false;       // Una llegada interrumpe en el acto al proceso de un nivel inferior
+    long long boost = 0;           // Cada cuánto vuelven todos los procesos a la cola 0 (0 = nunca)
+    long long envejecimiento = 0;  // Espera tras la cual un proceso sube un nivel (0 = nunca)
+    int nucleos = 1;               // Número de CPUs simuladas
+    int umbralRobo = 1;            // Procesos en espera que debe tener un núcleo para que le roben
+    long long costoMigracion = 0;  // Tiempo que paga un proceso robado antes de ejecutarse
+    bool detalle = true;           // Guardar cada proceso completado para imprimir su fila
+    Instrumentacion* instrumentacion = nullptr; // Contadores por nivel y línea de tiempo (opcional)
+    string rutaCheckpoint;         // Archivo donde guardar los puntos de control
+    long long checkpointEn = -1;   // Tiempo del primer punto de control (-1 = ninguno)
+    long long checkpointCada = 0;  // Periodo entre puntos de control (0 = solo uno)
+    bool soloCheckpoint = false;   // Detener la simulación tras el primer punto de control
+};
+
+// Resultado de una simulación: orden de terminación y contadores
+struct ResultadoMLFQ {
+    vector<uint32_t> resp;          // Indices de los procesos completados (si opciones.detalle)
+    Metricas metricas;              // Promedios y percentiles de los completados
+    long long cambiosContexto = 0;  // Veces que una CPU pasa a otro proceso
+    long long expropiaciones = 0;   // Pedazos cortados por una llegada (modo preemptivo)
+    long long boosts = 0;           // Boosts de prioridad aplicados
+    long long promociones = 0;      // Procesos subidos por envejecimiento
+    long long robos = 0;            // Procesos robados entre núcleos
+    long long costoMigracion = 0;   // Tiempo total pagado por los robos
+    vector<long long> ocupado;      // Tiempo ejecutando procesos de cada núcleo (con varios núcleos)
+    vector<long long> robosNucleo;  // Procesos robados por cada núcleo
+    long long duracion = 0;         // Desde la primera llegada hasta el último fin (con varios núcleos)
+    long long checkpoints = 0;      // Puntos de control guardados
+    bool interrumpido = false;      // Se detuvo en un punto de control (opciones.soloCheckpoint)
+};
+
+// Variables del ciclo de simulación. Al comienzo de una vuelta del ciclo (o
+// entre dos pedazos, si las colas de mayor prioridad están vacías), junto con
+// el estado de los procesos, las colas y el resultado parcial, bastan para
+// continuar la simulación
+struct CicloMLFQ {
+    long long tiempo = 0;
+    uint32_t enEspera = 0;
+    uint32_t ultimo = NINGUNO;
+    long long proximoBoost = -1;  // -1 = el primero según opciones.boost
+    uint32_t llegados = 0;        // Procesos ya tomados de la tabla
+
+    // Campo por campo: la estructura tiene relleno que no debe ir al archivo
+    void guardar(ostream& out) const {
+        escribirBin(out, tiempo);
+        escribirBin(out, enEspera);
+        escribirBin(out, ultimo);
+        escribirBin(out, proximoBoost);
+        escribirBin(out, llegados);
     }
+    bool cargar(istream& in) {
+        return leerBin(in, tiempo) && leerBin(in, enEspera) && leerBin(in, ultimo) &&
+               leerBin(in, proximoBoost) && leerBin(in, llegados);
+    }
+};
 
-    out << "WT=" << avgs[2]
-        << "; CT=" << avgs[0]
-        << "; RT=" << avgs[3]
-        << "; TAT=" << avgs[1] << ";\n";
+// Huella de los datos de entrada (FNV-1a) para comprobar que un punto de
+// control se restaura sobre la misma traza
+uint64_t huellaTabla(const TablaProcesos& t) {
+    uint64_t h = 1469598103934665603ULL;
+    auto mezclar = [&h](long long v) {
+        for (int b = 0; b < 8; b++) {
+            h ^= (v >> (8 * b)) & 0xff;
+            h *= 1099511628211ULL;
+        }
+    };
+    for (uint32_t p = 0; p < t.size(); p++) {
+        mezclar(t.arrival_time[p]);
+        mezclar(t.burst_time[p]);
+        mezclar(t.cola[p]);
+        mezclar(t.priority[p]);
+    }
+    return h;
+}
+
+// Guarda el estado completo de la simulación en 'ruta'. Se escribe primero a
+// un archivo temporal y luego se renombra, así que un corte a la mitad deja
+// intacto el punto de control anterior
+bool guardarPuntoControl(const string& ruta, const TablaProcesos& t, const EstadoProcesos& e,
+                         const Scheduler& scheduler, const CicloMLFQ& ciclo,
+                         const ResultadoMLFQ& r, long long boost) {
+    string temporal = ruta + ".tmp";
+    ofstream out(temporal, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        cerr << "Error: no se pudo crear " << temporal << endl;
+        return false;
+    }
+    out.write("MLFQCP02", 8);
+    escribirBin(out, (uint64_t)t.size());
+    escribirBin(out, huellaTabla(t));
+
+    // Colas: política (debe coincidir al restaurar) y contenido
+    escribirBin(out, (uint32_t)scheduler.queues.size());
+    for (const Cola& c : scheduler.queues) {
+        escribirBin(out, (int32_t)c.politica);
+        escribirBin(out, c.primero);
+        escribirBin(out, c.ultimo);
+        escribirBin(out, c.ultimoServicio);
+        escribirBin(out, c.tam);
+    }
+    escribirBin(out, scheduler.siguiente);
+    escribirBin(out, scheduler.hijo);
+    escribirBin(out, scheduler.clave);
+    escribirBin(out, scheduler.encolado);
+
+    ciclo.guardar(out);
+    escribirBin(out, boost);
+
+    escribirBin(out, e.tiempoRestante);
+    escribirBin(out, e.nivel);
+    escribirBin(out, e.primeraVez);
+    escribirBin(out, e.ComTim);
+    escribirBin(out, e.ResTim);
+
+    escribirBin(out, r.resp);
+    r.metricas.guardar(out);
+    escribirBin(out, r.cambiosContexto);
+    escribirBin(out, r.expropiaciones);
+    escribirBin(out, r.boosts);
+    escribirBin(out, r.promociones);
 
     out.close();
+    if (!out || rename(temporal.c_str(), ruta.c_str()) != 0) {
+        cerr << "Error: no se pudo escribir " << ruta << endl;
+        return false;
+    }
+    return true;
 }
 
-void MLFQ(vector<proceso> &procesos, Scheduler& scheduler) {
-    int tiempo = 0, completados = 0;
-    int n = procesos.size();
-    vector<proceso> resp;
+// Recupera un punto de control guardado con guardarPuntoControl sobre la
+// misma tabla y con las mismas políticas por nivel (los quantums, el boost,
+// el envejecimiento y el modo preemptivo pueden cambiar para continuar con
+// otra configuración). Deja el scheduler y el estado listos para seguir
+bool cargarPuntoControl(const string& ruta, const TablaProcesos& t, EstadoProcesos& e,
+                        Scheduler& scheduler, CicloMLFQ& ciclo, ResultadoMLFQ& r, long long& boost) {
+    ifstream in(ruta, ios::binary);
+    if (!in.is_open()) {
+        cerr << "Error: no se pudo abrir " << ruta << endl;
+        return false;
+    }
+    auto malo = [&ruta](const char* motivo) {
+        cerr << "Error: " << ruta << ": punto de control no valido: " << motivo << endl;
+        return false;
+    };
 
-    // Ordenar procesos por tiempo de llegada
-    sort(procesos.begin(), procesos.end(),
-         [](proceso &a, proceso &b) {
-             return a.arrival_time < b.arrival_time;
-         });
+    char magia[8];
+    uint64_t n = 0, huella = 0;
+    if (!in.read(magia, 8) || memcmp(magia, "MLFQCP02", 8) != 0) return malo("formato desconocido");
+    if (!leerBin(in, n) || !leerBin(in, huella)) return malo("archivo truncado");
+    if (n != t.size() || huella != huellaTabla(t)) return malo("se guardo con otra traza");
 
-    int idx = 0; // procesos que van llegando
+    uint32_t niveles = 0;
+    if (!leerBin(in, niveles)) return malo("archivo truncado");
+    if (niveles != scheduler.queues.size()) return malo("el numero de colas no coincide");
+    e.reiniciar(t);
+    scheduler.preparar(t, e);
+    for (Cola& c : scheduler.queues) {
+        int32_t politica;
+        if (!leerBin(in, politica)) return malo("archivo truncado");
+        if (politica != (int32_t)c.politica) return malo("la politica de las colas no coincide");
+        if (!leerBin(in, c.primero) || !leerBin(in, c.ultimo) || !leerBin(in, c.ultimoServicio) ||
+            !leerBin(in, c.tam)) {
+            return malo("archivo truncado");
+        }
+    }
+
+    bool ok = leerBin(in, scheduler.siguiente, n) && leerBin(in, scheduler.hijo, n) &&
+              leerBin(in, scheduler.clave, n) && leerBin(in, scheduler.encolado, n) &&
+              ciclo.cargar(in) && leerBin(in, boost) &&
+              leerBin(in, e.tiempoRestante, n) && leerBin(in, e.nivel, n) &&
+              leerBin(in, e.primeraVez, n) && leerBin(in, e.ComTim, n) && leerBin(in, e.ResTim, n) &&
+              leerBin(in, r.resp, n) && r.metricas.cargar(in) &&
+              leerBin(in, r.cambiosContexto) && leerBin(in, r.expropiaciones) &&
+              leerBin(in, r.boosts) && leerBin(in, r.promociones);
+    if (!ok) return malo("archivo truncado");
+    for (size_t tam : {scheduler.siguiente.size(), scheduler.hijo.size(), scheduler.clave.size(),
+                       scheduler.encolado.size(), e.tiempoRestante.size(), e.nivel.size(),
+                       e.primeraVez.size(), e.ComTim.size(), e.ResTim.size()}) {
+        if (tam != n) return malo("tamanos inconsistentes");
+    }
+    if (ciclo.llegados > n || ciclo.enEspera > n) return malo("tamanos inconsistentes");
+
+    // La huella cubre la traza, no el cuerpo del archivo: cada índice leído
+    // se valida antes de usarlo para que un archivo dañado no se salga de las tablas
+    auto indiceOk = [n](uint32_t p) { return p == NINGUNO || p < n; };
+    for (const Cola& c : scheduler.queues) {
+        if (!indiceOk(c.primero) || !indiceOk(c.ultimo) || c.tam > n) return malo("indice fuera de rango");
+    }
+    for (uint32_t p = 0; p < n; p++) {
+        if (!indiceOk(scheduler.siguiente[p]) || !indiceOk(scheduler.hijo[p]) ||
+            e.nivel[p] < 0 || e.nivel[p] >= (int)niveles) {
+            return malo("indice fuera de rango");
+        }
+    }
+    if (!indiceOk(ciclo.ultimo)) return malo("indice fuera de rango");
+    for (uint32_t p : r.resp) {
+        if (p >= n) return malo("indice fuera de rango");
+    }
+
+    // Recorrer cada cola: sin ciclos, sin procesos repetidos, con el largo y
+    // el último que dice su cabecera, y solo con procesos a los que les falta tiempo
+    vector<char> visto(n, 0);
+    uint64_t total = 0;
+    for (const Cola& c : scheduler.queues) {
+        vector<uint32_t> pendientes;
+        if (c.primero != NINGUNO) pendientes.push_back(c.primero);
+        uint32_t cuenta = 0, fin = NINGUNO;
+        while (!pendientes.empty()) {
+            uint32_t p = pendientes.back();
+            pendientes.pop_back();
+            if (visto[p] || ++cuenta > c.tam) return malo("colas inconsistentes");
+            if (e.tiempoRestante[p] <= 0 || e.tiempoRestante[p] > t.burst_time[p]) {
+                return malo("colas inconsistentes");
+            }
+            visto[p] = 1;
+            fin = p;
+            if (scheduler.siguiente[p] != NINGUNO) pendientes.push_back(scheduler.siguiente[p]);
+            if (c.es_monticulo() && scheduler.hijo[p] != NINGUNO) pendientes.push_back(scheduler.hijo[p]);
+        }
+        if (cuenta != c.tam || (!c.es_monticulo() && fin != c.ultimo)) return malo("colas inconsistentes");
+        total += cuenta;
+    }
+    if (total != ciclo.enEspera) return malo("colas inconsistentes");
+    // Fuera de las colas solo quedan los que ya terminaron y los que no han llegado
+    for (uint32_t p = 0; p < n; p++) {
+        if (visto[p]) continue;
+        long long esperado = p < ciclo.llegados ? 0 : t.burst_time[p];
+        if (e.tiempoRestante[p] != esperado) return malo("colas inconsistentes");
+    }
+    return true;
+}
+
+// Funcion para imprimir los contadores de la simulación
+void printContadores(const ResultadoMLFQ& r, const OpcionesMLFQ& opciones, ostream& out = cout) {
+    out << "Cambios de contexto: " << r.cambiosContexto;
+    if (opciones.preemptivo || r.expropiaciones > 0) out << " (" << r.expropiaciones << " por expropiacion)";
+    out << endl;
+    if (opciones.nucleos > 1) {
+        out << "Robos de trabajo: " << r.robos << " (costo de migracion: " << r.costoMigracion << ")" << endl;
+    }
+    if (opciones.boost > 0) out << "Boosts de prioridad: " << r.boosts << endl;
+    if (opciones.envejecimiento > 0) out << "Promociones por envejecimiento: " << r.promociones << endl;
+}
+
+// Funcion para imprimir la utilización de cada núcleo (solo con varios núcleos)
+void printNucleos(const ResultadoMLFQ& r, ostream& out = cout) {
+    if (r.ocupado.empty()) return;
+    long long ocupadoTotal = 0;
+    out << "Nucleo; Utilizacion(%); Ocupado; Robos" << endl;
+    for (size_t c = 0; c < r.ocupado.size(); c++) {
+        out << c << "; " << fixed << setprecision(2) << 100.0 * r.ocupado[c] / r.duracion
+            << defaultfloat << "; " << r.ocupado[c] << "; " << r.robosNucleo[c] << endl;
+        ocupadoTotal += r.ocupado[c];
+    }
+    out << "Utilizacion media: " << fixed << setprecision(2)
+        << 100.0 * ocupadoTotal / ((double)r.duracion * r.ocupado.size()) << "%" << defaultfloat << endl;
+}
+
+// Eventos de la línea de tiempo
+enum EventoTimeline : uint16_t {
+    EV_LLEGADA = 0,      // El proceso llega a la cola 0
+    EV_DESPACHO = 1,     // Empieza un pedazo en la CPU
+    EV_EXPROPIACION = 2, // Su pedazo fue cortado por una llegada y vuelve a su nivel
+    EV_DEGRADACION = 3,  // Agotó el quantum y baja al nivel indicado
+    EV_REENCOLADO = 4,   // Agotó el quantum en el último nivel y vuelve a él
+    EV_TERMINACION = 5,  // Se completó
+    EV_BOOST = 6,        // Boost de prioridad (pid = NINGUNO)
+    EV_PROMOCION = 7     // Hubo envejecimiento hasta el nivel indicado (pid = NINGUNO)
+};
+
+// Registro de la línea de tiempo tal como queda en el archivo (16 bytes,
+// orden de bytes de la máquina). El pid es el índice del proceso en la tabla
+// ordenada por llegada (en modo en línea, el lugar que ocupa mientras vive)
+struct RegistroTimeline {
+    int64_t tiempo;
+    uint32_t pid;
+    uint16_t nivel;
+    uint16_t evento;
+};
+static_assert(sizeof(RegistroTimeline) == 16, "el formato del timeline es de 16 bytes");
+
+// Escritor de la línea de tiempo: solo agrega registros al final y los
+// acumula en un buffer para escribirlos en bloques grandes. El archivo empieza
+// con "MLFQTL01" seguido de la versión y el tamaño del registro (uint32 cada
+// uno), así que desde numpy se lee con fromfile(offset=16) y un dtype de
+// ('=i8', '=u4', '=u2', '=u2'). Todo va en el orden de bytes de la máquina que
+// lo escribió (el mismo de RegistroTimeline); en x86 y ARM es little-endian
+class EscritorTimeline {
+public:
+    ~EscritorTimeline() { cerrar(); }
+
+    bool abrir(const string& ruta) {
+        out.open(ruta, ios::binary | ios::trunc);
+        if (!out.is_open()) return false;
+        const uint32_t version = 1, tamRegistro = sizeof(RegistroTimeline);
+        out.write("MLFQTL01", 8);
+        out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        out.write(reinterpret_cast<const char*>(&tamRegistro), sizeof(tamRegistro));
+        buffer.reserve(CAPACIDAD);
+        return true;
+    }
+
+    void agregar(long long tiempo, uint32_t pid, int nivel, EventoTimeline evento) {
+        buffer.push_back({tiempo, pid, (uint16_t)nivel, evento});
+        if (buffer.size() == CAPACIDAD) vaciar();
+    }
+
+    long long registros() const { return escritos + buffer.size(); }
+
+    void cerrar() {
+        if (!out.is_open()) return;
+        vaciar();
+        out.close();
+    }
+
+private:
+    static const size_t CAPACIDAD = 1 << 14; // 256 KB por escritura
+    ofstream out;
+    vector<RegistroTimeline> buffer;
+    long long escritos = 0;
+
+    void vaciar() {
+        out.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(RegistroTimeline));
+        escritos += buffer.size();
+        buffer.clear();
+    }
+};
+
+// Instrumentación por nivel de una simulación. Solo se llena si se pasa en
+// las opciones; sin ella el ciclo no paga más que revisar un puntero nulo
+struct Instrumentacion {
+    vector<long long> pedazos;          // Pedazos despachados desde cada nivel
+    vector<long long> tiempoEjecucion;  // CPU usada por los procesos en cada nivel
+    vector<long long> degradaciones;    // Procesos que bajaron desde cada nivel
+    vector<uint32_t> profundidadMax;    // Máximo de procesos esperando en cada nivel
+    vector<double> areaProfundidad;     // Profundidad integrada en el tiempo (para el promedio)
+    long long inicio = -1;              // Primer y último instante muestreado
+    long long ultimoMuestreo = 0;
+    EscritorTimeline* timeline = nullptr; // Línea de tiempo binaria (opcional)
+
+    void iniciar(int niveles) {
+        pedazos.assign(niveles, 0);
+        tiempoEjecucion.assign(niveles, 0);
+        degradaciones.assign(niveles, 0);
+        profundidadMax.assign(niveles, 0);
+        areaProfundidad.assign(niveles, 0);
+        inicio = -1;
+        ultimoMuestreo = 0;
+    }
+
+    // Acumula la profundidad de cada cola desde el último muestreo hasta ahora
+    void muestrear(const Scheduler& s, long long ahora) {
+        if (inicio < 0) inicio = ultimoMuestreo = ahora;
+        long long dt = ahora - ultimoMuestreo;
+        for (size_t l = 0; l < s.queues.size(); l++) {
+            uint32_t tam = s.queues[l].tam;
+            areaProfundidad[l] += (double)tam * dt;
+            if (tam > profundidadMax[l]) profundidadMax[l] = tam;
+        }
+        ultimoMuestreo = ahora;
+    }
+
+    void evento(long long tiempo, uint32_t pid, int nivel, EventoTimeline ev) {
+        if (timeline) timeline->agregar(tiempo, pid, nivel, ev);
+    }
+};
+
+// Funcion para imprimir la tabla de instrumentación por nivel
+void printInstrumentacion(const Instrumentacion& inst, ostream& out = cout) {
+    long long duracion = inst.inicio < 0 ? 0 : inst.ultimoMuestreo - inst.inicio;
+    long long degradaciones = 0;
+    out << "Nivel; Pedazos; Tiempo CPU; Degradaciones; Profundidad media; Profundidad max" << endl;
+    for (size_t l = 0; l < inst.pedazos.size(); l++) {
+        out << l << "; " << inst.pedazos[l] << "; " << inst.tiempoEjecucion[l] << "; "
+            << inst.degradaciones[l] << "; " << fixed << setprecision(2)
+            << (duracion > 0 ? inst.areaProfundidad[l] / duracion : 0.0) << defaultfloat << "; "
+            << inst.profundidadMax[l] << endl;
+        degradaciones += inst.degradaciones[l];
+    }
+    out << "Degradaciones: " << degradaciones << endl;
+    if (inst.timeline) out << "Registros de timeline: " << inst.timeline->registros() << endl;
+}
+
+// Ciclo de simulación MLFQ en una CPU. Las llegadas vienen de 'fuente', que
+// ofrece:
+//   pendiente()  ¿queda alguna llegada? (puede esperar a que haya datos)
+//   proxima()    tiempo de la siguiente llegada
+//   proximaRafaga() burst time de la siguiente llegada (para expropiar en SRTF)
+//   tomar()      índice en la tabla del proceso que llega, ya con su estado inicial
+//   terminar(p)  avisa que p se completó (sus métricas ya están registradas)
+//   llegados()   cuántos procesos se han tomado
+// La simulación empieza en 'inicio' con el resultado parcial 'r' (por
+// defecto desde cero; al restaurar un punto de control, donde quedó)
+template <class Fuente>
+ResultadoMLFQ simularMLFQ(Fuente& fuente, const TablaProcesos &t, EstadoProcesos& e,
+                          Scheduler& scheduler, const OpcionesMLFQ& opciones,
+                          const CicloMLFQ& inicio = CicloMLFQ(), ResultadoMLFQ r = ResultadoMLFQ()) {
+    long long tiempo = inicio.tiempo; // Reloj de la simulacion (64 bits: trazas de hasta 10^12 unidades)
+    uint32_t enEspera = inicio.enEspera; // Procesos que estan en alguna cola
+    uint32_t ultimo = inicio.ultimo;     // Último proceso que ocupó la CPU
+    // Tiempo del siguiente boost de prioridad
+    long long proximoBoost = inicio.proximoBoost >= 0 ? inicio.proximoBoost : opciones.boost;
+    // Tiempo del siguiente punto de control (-1 = ninguno); los que ya
+    // quedaron atrás del punto de partida no se repiten
+    long long proximoCheckpoint = opciones.checkpointEn;
+    if (opciones.checkpointCada > 0 && proximoCheckpoint >= 0 && proximoCheckpoint <= tiempo) {
+        proximoCheckpoint = (tiempo / opciones.checkpointCada + 1) * opciones.checkpointCada;
+    } else if (proximoCheckpoint >= 0 && proximoCheckpoint < tiempo) {
+        proximoCheckpoint = -1;
+    }
+    Instrumentacion* inst = opciones.instrumentacion;
+    if (inst) inst->iniciar(scheduler.queues.size());
+
+    // Aplica el boost y el envejecimiento que correspondan al tiempo actual.
+    // Devuelve el nivel más alto que recibió procesos (o el número de colas si ninguno)
+    auto migrar = [&]() {
+        int nivelMin = scheduler.queues.size();
+        if (opciones.boost > 0 && tiempo >= proximoBoost) {
+            for (int l = 1; l < (int)scheduler.queues.size(); l++) {
+                if (!scheduler.queues[l].is_empty()) nivelMin = 0;
+                scheduler.empalmar_cola(l, 0, tiempo);
+            }
+            proximoBoost = (tiempo / opciones.boost + 1) * opciones.boost;
+            r.boosts++;
+            if (inst) inst->evento(tiempo, NINGUNO, 0, EV_BOOST);
+        }
+        if (opciones.envejecimiento > 0) {
+            long long subidos = scheduler.envejecer(tiempo, opciones.envejecimiento, nivelMin,
+                                                    0, scheduler.queues.size());
+            r.promociones += subidos;
+            if (inst && subidos > 0) inst->evento(tiempo, NINGUNO, nivelMin, EV_PROMOCION);
+        }
+        return nivelMin;
+    };
+
+    // Guarda un punto de control si ya toca. Solo se llama donde seguir
+    // equivale a empezar una vuelta del ciclo; true si hay que detenerse
+    auto puntoControl = [&]() {
+        if (proximoCheckpoint < 0 || tiempo < proximoCheckpoint) return false;
+        CicloMLFQ ciclo{tiempo, enEspera, ultimo, proximoBoost, fuente.llegados()};
+        if (guardarPuntoControl(opciones.rutaCheckpoint, t, e, scheduler, ciclo, r, opciones.boost)) {
+            r.checkpoints++;
+        }
+        proximoCheckpoint = opciones.checkpointCada > 0
+            ? (tiempo / opciones.checkpointCada + 1) * opciones.checkpointCada : -1;
+        r.interrumpido = opciones.soloCheckpoint;
+        return r.interrumpido;
+    };
 
     // Se ejecuta hasta que todos los procesos se completen
-    while (completados < n) {
+    while (enEspera > 0 || fuente.pendiente()) {
+        // Punto de control al comienzo de la vuelta
+        if (puntoControl()) return r;
+
+        // Muestrear antes del salto y de las llegadas: el tiempo ocioso cuenta
+        // con las colas como estaban, no con los procesos que están por llegar
+        if (inst) inst->muestrear(scheduler, tiempo);
+
+        // Si no hay nadie en las colas, saltar el reloj a la siguiente llegada
+        // en lugar de avanzar de uno en uno (el tiempo ocioso no cuesta nada)
+        if (enEspera == 0 && fuente.proxima() > tiempo) {
+            tiempo = fuente.proxima();
+            if (inst) inst->muestrear(scheduler, tiempo);
+        }
+
         // Encolar los procesos que llegan
-        while (idx < n && procesos[idx].arrival_time <= tiempo) {
-            scheduler.queues[0].add_process(procesos[idx]);
-            idx++;
+        while (fuente.pendiente() && fuente.proxima() <= tiempo) {
+            uint32_t p = fuente.tomar();
+            scheduler.add_process(0, p, tiempo);
+            enEspera++;
+            if (inst) inst->evento(tiempo, p, 0, EV_LLEGADA);
         }
+        migrar();
+        if (inst) inst->muestrear(scheduler, tiempo);
 
-        bool ejecutado = false;
         // Revisar las colas en orden de prioridad
-        for (int i = 0; i < scheduler.queues.size(); i++) {
+        bool reiniciar = false;
+        for (int i = 0; i < scheduler.queues.size() && !reiniciar; i++) {
             // La cola se ejecuta hasta que se vacíe o llegue un proceso de mayor prioridad
             while (!scheduler.queues[i].is_empty()) {
-                proceso current = scheduler.queues[i].procesos.front();
-                scheduler.queues[i].procesos.pop();
+                uint32_t current = scheduler.pop_process(i, tiempo);
+                e.nivel[current] = i;
+                if (current != ultimo) r.cambiosContexto++;
+                ultimo = current;
 
                 // Si se llega un proceso por primera vez, registrar su tiempo de respuesta
-                if (current.primeraVez) {
-                    current.ResTim = tiempo;
-                    current.primeraVez = false;
+                if (e.primeraVez[current]) {
+                    e.ResTim[current] = tiempo;
+                    e.primeraVez[current] = false;
                 }
 
-                //Calcular el quantum a usar ya que es round robin
-                int tiempoPedazo = min(current.tiempoRestante, scheduler.queues[i].quantum);
+                // Calcular el pedazo a ejecutar: el quantum del nivel, o hasta terminar si es 0
+                long long tiempoPedazo = e.tiempoRestante[current];
+                if (scheduler.queues[i].quantum > 0) {
+                    tiempoPedazo = min(tiempoPedazo, (long long)scheduler.queues[i].quantum);
+                }
+                // En modo preemptivo, una llegada a la cola 0 corta el pedazo
+                // de un nivel inferior justo en su tiempo de llegada
+                bool expropiado = false;
+                if (opciones.preemptivo && i > 0 && fuente.pendiente() &&
+                    fuente.proxima() < tiempo + tiempoPedazo) {
+                    tiempoPedazo = fuente.proxima() - tiempo;
+                    expropiado = true;
+                    r.expropiaciones++;
+                }
+                if (inst) inst->evento(tiempo, current, i, EV_DESPACHO);
+                // SRTF en la cola 0 (la que recibe las llegadas) es expropiativo:
+                // las llegadas del pedazo entran a la cola en su tiempo y la
+                // primera más corta que lo que le queda al proceso corta el pedazo
+                if (i == 0 && scheduler.queues[0].politica == Politica::SRTF) {
+                    while (fuente.pendiente() && fuente.proxima() < tiempo + tiempoPedazo) {
+                        long long llegada = fuente.proxima();
+                        if (fuente.proximaRafaga() < e.tiempoRestante[current] - (llegada - tiempo)) {
+                            tiempoPedazo = llegada - tiempo;
+                            expropiado = true;
+                            r.expropiaciones++;
+                            break;
+                        }
+                        if (inst) inst->muestrear(scheduler, llegada);
+                        uint32_t p = fuente.tomar();
+                        scheduler.add_process(0, p, llegada);
+                        enEspera++;
+                        if (inst) inst->evento(llegada, p, 0, EV_LLEGADA);
+                    }
+                }
+                if (inst) {
+                    inst->pedazos[i]++;
+                    inst->tiempoEjecucion[i] += tiempoPedazo;
+                }
                 tiempo += tiempoPedazo;
-                current.tiempoRestante -= tiempoPedazo;
+                e.tiempoRestante[current] -= tiempoPedazo;
+                if (inst) inst->muestrear(scheduler, tiempo);
+
+                // Si el proceso se completa registrar su tiempo y añadirlo a
+                // resultados. Va antes de revisar las llegadas: en modo en
+                // línea eso puede bloquear esperando la entrada, y la fila del
+                // proceso terminado tiene que salir antes
+                bool completado = e.tiempoRestante[current] == 0;
+                if (completado) {
+                    e.ComTim[current] = tiempo;
+                    r.metricas.registrar(t, e, current);
+                    enEspera--;
+                    if (inst) inst->evento(tiempo, current, i, EV_TERMINACION);
+                    fuente.terminar(current, r);
+                    // Su lugar puede reutilizarse para otro proceso
+                    ultimo = NINGUNO;
+                }
 
                 // Encolar nuevos procesos que llegaron en este tiempo
-                while (idx < n && procesos[idx].arrival_time <= tiempo) {
-                    scheduler.queues[0].add_process(procesos[idx]);
-                    idx++;
+                while (fuente.pendiente() && fuente.proxima() <= tiempo) {
+                    uint32_t p = fuente.tomar();
+                    scheduler.add_process(0, p, tiempo);
+                    enEspera++;
+                    if (inst) inst->evento(tiempo, p, 0, EV_LLEGADA);
                 }
 
-                // Si el proceso se completa calcular métricas y añadir a resultados
-                if (current.tiempoRestante == 0) {
-                    current.ComTim = tiempo;
-                    current.TuArTi = current.ComTim - current.arrival_time;
-                    current.WaiTim = current.TuArTi - current.burst_time;
-                    resp.push_back(current);
-                    completados++;
-                } else {
+                // Si no se completó, vuelve detrás de los que acaban de llegar
+                if (!completado && expropiado) {
+                    // No agotó su quantum: vuelve a su nivel sin bajar
+                    scheduler.add_process(i, current, tiempo);
+                    if (inst) inst->evento(tiempo, current, i, EV_EXPROPIACION);
+                } else if (!completado) {
                     // Si no se completa, bajar de nivel si es posible y reencolar
-                    if (current.nivel < scheduler.queues.size() - 1) {
-                        current.nivel++;
+                    if (e.nivel[current] < scheduler.queues.size() - 1) {
+                        e.nivel[current]++;
+                    }
+                    scheduler.add_process(e.nivel[current], current, tiempo);
+                    if (inst) {
+                        bool bajo = e.nivel[current] != i;
+                        if (bajo) inst->degradaciones[i]++;
+                        inst->evento(tiempo, current, e.nivel[current], bajo ? EV_DEGRADACION : EV_REENCOLADO);
                     }
-                    scheduler.queues[current.nivel].add_process(current);
                 }
 
-                ejecutado = true;
+                // Boost y envejecimiento; si subió alguien por encima de este
+                // nivel, volver a revisar desde la cola 0
+                int nivelMin = migrar();
+                if (inst) inst->muestrear(scheduler, tiempo);
+
+                // Punto de control entre pedazos (con carga sostenida la cola 0
+                // no se vacía y el ciclo no vuelve al comienzo). Si las colas
+                // de mayor prioridad están vacías, seguir en este nivel es lo
+                // mismo que empezar otra vuelta
+                if (proximoCheckpoint >= 0 && tiempo >= proximoCheckpoint) {
+                    bool arribaVacias = true;
+                    for (int l = 0; l < i && arribaVacias; l++) arribaVacias = scheduler.queues[l].is_empty();
+                    if (arribaVacias && puntoControl()) return r;
+                }
+                if (nivelMin < i) {
+                    reiniciar = true;
+                    break;
+                }
+
                 // Si llego un proceso a la cola 0, interrumpir y atenderlo
                 if (!scheduler.queues[0].is_empty() && i != 0) {
+                    // En modo preemptivo se vuelve a revisar desde la cola 0
+                    reiniciar = opciones.preemptivo;
                     break;
                 }
-                
+
             }
         }
+    }
+
+    return r;
+}
 
-        // Si no se ejecutó ningún proceso, avanzar el tiempo
-        if (!ejecutado) tiempo++; // Si no hay nada, avanza el tiempo
+// Llegadas desde una tabla completa ya ordenada por tiempo de llegada
+class FuenteTabla {
+public:
+    FuenteTabla(const TablaProcesos& t, bool detalle, uint32_t llegados = 0)
+        : t(t), detalle(detalle), idx(llegados) {}
+
+    bool pendiente() const { return idx < t.size(); }
+    long long proxima() const { return t.arrival_time[idx]; }
+    long long proximaRafaga() const { return t.burst_time[idx]; }
+    uint32_t tomar() { return idx++; }
+    void terminar(uint32_t p, ResultadoMLFQ& r) {
+        if (detalle) r.resp.push_back(p);
     }
+    uint32_t llegados() const { return idx; }
 
-    // Imprimir resultados
-    printResultados(resp);
+private:
+    const TablaProcesos& t;
+    bool detalle;
+    uint32_t idx; // procesos que van llegando
+};
+
+// Simula MLFQ en una CPU. La tabla debe estar ordenada por tiempo de llegada;
+// el estado se reinicia aquí y al final contiene los tiempos de cada proceso
+ResultadoMLFQ MLFQ(const TablaProcesos &t, EstadoProcesos& e, Scheduler& scheduler,
+                   const OpcionesMLFQ& opciones) {
+    e.reiniciar(t);
+    scheduler.preparar(t, e);
+    FuenteTabla fuente(t, opciones.detalle);
+    ResultadoMLFQ r = simularMLFQ(fuente, t, e, scheduler, opciones);
+    return r;
+}
+
+// Continúa una simulación desde el punto de control guardado en 'ruta'. Las
+// opciones pueden diferir de las de la corrida original, así que varias
+// continuaciones distintas pueden partir del mismo punto sin repetir el
+// prefijo. Devuelve false si el punto de control no sirve para esta traza
+bool MLFQDesdePuntoControl(const string& ruta, const TablaProcesos &t, EstadoProcesos& e,
+                           Scheduler& scheduler, const OpcionesMLFQ& opciones, ResultadoMLFQ& r) {
+    CicloMLFQ ciclo;
+    long long boost = 0;
+    r = ResultadoMLFQ();
+    if (!cargarPuntoControl(ruta, t, e, scheduler, ciclo, r, boost)) return false;
+    // Con otro periodo de boost, el siguiente se calcula desde el tiempo guardado
+    if (boost != opciones.boost) {
+        ciclo.proximoBoost = opciones.boost > 0 ? (ciclo.tiempo / opciones.boost + 1) * opciones.boost : 0;
+    }
+    FuenteTabla fuente(t, opciones.detalle, ciclo.llegados);
+    r = simularMLFQ(fuente, t, e, scheduler, opciones, ciclo, move(r));
+    return true;
+}
+
+// MLFQ con varios núcleos: cada núcleo tiene su propia jerarquía de colas
+// (en el scheduler, la cola del nivel l del núcleo c es la c * niveles + l).
+// Cada llegada va al núcleo con menos procesos asignados y un núcleo sin
+// trabajo le roba un proceso al núcleo con más procesos en espera, siempre
+// que ese tenga al menos umbralRobo. El proceso robado paga costoMigracion
+// antes de ejecutarse. Imprime la utilización de cada núcleo
+ResultadoMLFQ MLFQMultinucleo(const TablaProcesos &t, EstadoProcesos& e, const Scheduler& plantilla,
+                              const OpcionesMLFQ& opciones) {
+    const int nucleos = opciones.nucleos;
+    const int niveles = plantilla.queues.size();
+    uint32_t n = t.size();
+    uint32_t completados = 0;
+    ResultadoMLFQ r;
+    if (opciones.detalle) r.resp.reserve(n);
+    long long fin = 0; // Último tiempo de fin
+
+    // Replicar las colas de la plantilla en cada núcleo
+    Scheduler scheduler;
+    for (int c = 0; c < nucleos; c++) {
+        for (const Cola& cola : plantilla.queues) {
+            scheduler.add_queue(c * niveles + cola.nivel, cola.tipo, cola.quantum);
+        }
+    }
+
+    e.reiniciar(t);
+    scheduler.preparar(t, e);
+
+    // Estado de cada núcleo
+    vector<uint32_t> enEjecucion(nucleos, NINGUNO); // Proceso en la CPU
+    vector<uint32_t> ultimo(nucleos, NINGUNO);      // Último proceso que ocupó la CPU
+    vector<uint32_t> asignados(nucleos, 0);         // Procesos del núcleo sin terminar
+    vector<uint32_t> enEspera(nucleos, 0);          // Procesos en las colas del núcleo
+    vector<long long> ocupado(nucleos, 0);          // Tiempo ejecutando procesos
+    vector<long long> robos(nucleos, 0);            // Procesos robados por el núcleo
+    vector<long long> proximoBoost(nucleos, opciones.boost);
+    long long periodoBoost = 0;                     // Último periodo de boost ya contado
+    vector<int> ociosos;                            // Núcleos dormidos sin trabajo
+
+    // Eventos (tiempo, núcleo): el núcleo termina su pedazo o despierta
+    priority_queue<pair<long long, int>, vector<pair<long long, int>>, greater<>> eventos;
+    for (int c = nucleos - 1; c >= 0; c--) ociosos.push_back(c);
+
+    // Despierta a un núcleo ocioso si el núcleo c acumula trabajo para robar
+    auto avisarRobo = [&](int c, long long ahora) {
+        if (!ociosos.empty() && (int)enEspera[c] >= opciones.umbralRobo) {
+            eventos.push({ahora, ociosos.back()});
+            ociosos.pop_back();
+        }
+    };
+
+    uint32_t idx = 0; // procesos que van llegando
+    while (completados < n) {
+        // Las llegadas se atienden antes que los eventos de su mismo tiempo
+        if (idx < n && (eventos.empty() || t.arrival_time[idx] <= eventos.top().first)) {
+            long long ahora = t.arrival_time[idx];
+            int destino = 0;
+            for (int c = 1; c < nucleos; c++) {
+                if (asignados[c] < asignados[destino]) destino = c;
+            }
+            scheduler.add_process(destino * niveles, idx, ahora);
+            asignados[destino]++;
+            enEspera[destino]++;
+            idx++;
+            auto it = find(ociosos.begin(), ociosos.end(), destino);
+            if (it != ociosos.end()) {
+                ociosos.erase(it);
+                eventos.push({ahora, destino});
+            } else {
+                avisarRobo(destino, ahora);
+            }
+            continue;
+        }
+
+        auto [ahora, c] = eventos.top();
+        eventos.pop();
+        int base = c * niveles;
+
+        // Terminar el pedazo del proceso que estaba en la CPU
+        uint32_t actual = enEjecucion[c];
+        if (actual != NINGUNO) {
+            enEjecucion[c] = NINGUNO;
+            if (e.tiempoRestante[actual] == 0) {
+                e.ComTim[actual] = ahora;
+                r.metricas.registrar(t, e, actual);
+                if (opciones.detalle) r.resp.push_back(actual);
+                fin = max(fin, ahora);
+                completados++;
+                asignados[c]--;
+            } else {
+                // Si no se completa, bajar de nivel si es posible y reencolar
+                if (e.nivel[actual] < niveles - 1) e.nivel[actual]++;
+                scheduler.add_process(base + e.nivel[actual], actual, ahora);
+                enEspera[c]++;
+                avisarRobo(c, ahora);
+            }
+        }
+
+        // Boost y envejecimiento dentro de la jerarquía del núcleo
+        if (opciones.boost > 0 && ahora >= proximoBoost[c]) {
+            for (int l = 1; l < niveles; l++) scheduler.empalmar_cola(base + l, base, ahora);
+            proximoBoost[c] = (ahora / opciones.boost + 1) * opciones.boost;
+            // Cada núcleo aplica el boost por su cuenta, pero es uno solo por periodo
+            if (ahora / opciones.boost > periodoBoost) {
+                periodoBoost = ahora / opciones.boost;
+                r.boosts++;
+            }
+        }
+        if (opciones.envejecimiento > 0) {
+            int nivelMin = base + niveles;
+            r.promociones += scheduler.envejecer(ahora, opciones.envejecimiento, nivelMin, base, niveles);
+        }
+
+        // Elegir el siguiente proceso: primero las colas propias en orden de prioridad
+        int nivel = 0;
+        while (nivel < niveles && scheduler.queues[base + nivel].is_empty()) nivel++;
+        uint32_t siguiente = NINGUNO;
+        long long inicio = ahora;
+        if (nivel < niveles) {
+            siguiente = scheduler.pop_process(base + nivel, ahora);
+            enEspera[c]--;
+        } else {
+            // Sin trabajo propio: robar al núcleo con más procesos en espera
+            int victima = -1;
+            for (int v = 0; v < nucleos; v++) {
+                if (v != c && (int)enEspera[v] >= opciones.umbralRobo &&
+                    (victima < 0 || enEspera[v] > enEspera[victima])) victima = v;
+            }
+            if (victima >= 0) {
+                int baseV = victima * niveles;
+                nivel = 0;
+                while (scheduler.queues[baseV + nivel].is_empty()) nivel++;
+                siguiente = scheduler.pop_process(baseV + nivel, ahora);
+                enEspera[victima]--;
+                asignados[victima]--;
+                asignados[c]++;
+                robos[c]++;
+                r.robos++;
+                inicio += opciones.costoMigracion;
+                r.costoMigracion += opciones.costoMigracion;
+            }
+        }
+
+        // Nada que hacer: dormir hasta que llegue trabajo
+        if (siguiente == NINGUNO) {
+            ociosos.push_back(c);
+            continue;
+        }
+
+        // Ejecutar un pedazo en el núcleo
+        e.nivel[siguiente] = nivel;
+        if (siguiente != ultimo[c]) r.cambiosContexto++;
+        ultimo[c] = siguiente;
+        if (e.primeraVez[siguiente]) {
+            e.ResTim[siguiente] = inicio;
+            e.primeraVez[siguiente] = false;
+        }
+        long long tiempoPedazo = e.tiempoRestante[siguiente];
+        int quantum = scheduler.queues[base + nivel].quantum;
+        if (quantum > 0) tiempoPedazo = min(tiempoPedazo, (long long)quantum);
+        e.tiempoRestante[siguiente] -= tiempoPedazo;
+        ocupado[c] += tiempoPedazo;
+        enEjecucion[c] = siguiente;
+        eventos.push({inicio + tiempoPedazo, c});
+    }
+
+    // Para la utilización de cada núcleo entre la primera llegada y el último fin
+    r.duracion = n > 0 ? max(1LL, fin - t.arrival_time[0]) : 1;
+    r.ocupado = move(ocupado);
+    r.robosNucleo = move(robos);
+    return r;
+}
+
+// Configuración y promedios de una corrida del barrido
+struct FilaBarrido {
+    string colas;  // Colas en el formato de --colas (TIPO:Q,...)
+    int niveles;
+    Promedios avgs;
+};
+
+// Barrido de parámetros: simula la traza con cada número de niveles en
+// [nivelesMin, nivelesMax] y cada combinación no decreciente de quantums
+// (como en un MLFQ clásico, los niveles bajos no tienen quantum menor). Las
+// corridas se reparten entre 'hilos' trabajadores que comparten la tabla de
+// procesos (solo lectura); cada trabajador tiene su propio estado. Escribe
+// las configuraciones ordenadas por la métrica 'orden' (WT, TAT o RT)
+bool barridoMLFQ(const TablaProcesos& t, const OpcionesMLFQ& opciones, int nivelesMin, int nivelesMax,
+                 vector<int> quantums, unsigned hilos, const string& orden) {
+    sort(quantums.begin(), quantums.end());
+    quantums.erase(unique(quantums.begin(), quantums.end()), quantums.end());
+
+    // Enumerar las configuraciones
+    vector<FilaBarrido> filas;
+    const size_t maxConfiguraciones = 1000000;
+    for (int L = nivelesMin; L <= nivelesMax; L++) {
+        vector<int> eleccion(L, 0); // Índice en quantums de cada nivel, no decreciente
+        while (true) {
+            if (filas.size() == maxConfiguraciones) {
+                cerr << "Error: el barrido tiene mas de " << maxConfiguraciones << " configuraciones" << endl;
+                return false;
+            }
+            string colas;
+            for (int l = 0; l < L; l++) {
+                colas += (l ? ",RR:" : "RR:") + to_string(quantums[eleccion[l]]);
+            }
+            filas.push_back({colas, L, {}});
+
+            // Siguiente combinación no decreciente
+            int l = L - 1;
+            while (l >= 0 && eleccion[l] == (int)quantums.size() - 1) l--;
+            if (l < 0) break;
+            eleccion[l]++;
+            for (int k = l + 1; k < L; k++) eleccion[k] = eleccion[l];
+        }
+    }
+
+    // Repartir las corridas entre los trabajadores
+    if (hilos == 0) hilos = max(1u, thread::hardware_concurrency());
+    hilos = min<size_t>(hilos, filas.size());
+    atomic<size_t> proxima(0);
+    OpcionesMLFQ opcionesCorrida = opciones;
+    opcionesCorrida.detalle = false;
+    auto trabajador = [&]() {
+        EstadoProcesos e;
+        for (size_t k = proxima++; k < filas.size(); k = proxima++) {
+            Scheduler scheduler;
+            stringstream ss(filas[k].colas);
+            string nivel;
+            while (getline(ss, nivel, ',')) {
+                scheduler.add_queue(scheduler.queues.size(), "RR", atoi(nivel.c_str() + 3));
+            }
+            ResultadoMLFQ r = MLFQ(t, e, scheduler, opcionesCorrida);
+            filas[k].avgs = r.metricas.promedios();
+        }
+    };
+    vector<thread> trabajadores;
+    for (unsigned h = 0; h < hilos; h++) trabajadores.emplace_back(trabajador);
+    for (auto& th : trabajadores) th.join();
+
+    // Ordenar de mejor a peor según la métrica elegida
+    auto metrica = [&orden](const Promedios& p) {
+        return orden == "TAT" ? p.TAT : orden == "RT" ? p.RT : p.WT;
+    };
+    stable_sort(filas.begin(), filas.end(),
+        [&metrica](const FilaBarrido& a, const FilaBarrido& b) {
+            return metrica(a.avgs) < metrica(b.avgs);
+        });
+
+    string filename = "barrido_MLFQ.txt";
+    ofstream out(filename);
+    if (!out.is_open()) {
+        cerr << "Error al abrir archivo de salida\n";
+        return false;
+    }
+    out << "# archivo: " << filename << "\n";
+    out << "# " << filas.size() << " configuraciones ordenadas por " << orden << "\n";
+    out << "# rango; niveles; colas; WT; TAT; RT; CT\n";
+    for (size_t k = 0; k < filas.size(); k++) {
+        const FilaBarrido& f = filas[k];
+        out << k + 1 << ";" << f.niveles << ";" << f.colas << ";"
+            << f.avgs.WT << ";" << f.avgs.TAT << ";" << f.avgs.RT << ";" << f.avgs.CT << "\n";
+    }
+    out.close();
+
+    cout << "Barrido: " << filas.size() << " configuraciones con " << hilos << " hilos" << endl;
+    if (!filas.empty()) {
+        cout << "Mejor por " << orden << ": " << filas[0].colas << " (WT=" << filas[0].avgs.WT
+             << "; TAT=" << filas[0].avgs.TAT << "; RT=" << filas[0].avgs.RT << ")" << endl;
+    }
+    return true;
+}
+
+// Archivo de entrada mapeado en memoria (en Windows se lee completo a un buffer)
+class ArchivoMapeado {
+public:
+    const char* datos = nullptr; // Contenido del archivo
+    size_t tam = 0;              // Tamaño en bytes
+
+    // Método para abrir y mapear el archivo; devuelve false si no se pudo
+    bool abrir(const string& ruta) {
+#ifdef _WIN32
+        ifstream in(ruta, ios::binary);
+        if (!in.is_open()) return false;
+        buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+        datos = buffer.data();
+        tam = buffer.size();
+        return true;
+#else
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        if (!S_ISREG(st.st_mode)) {
+            // Tubería, FIFO o dispositivo (por ejemplo <(cat traza)): no se
+            // puede mapear ni se sabe su tamaño, así que se lee completo
+            char bloque[1 << 16];
+            ssize_t leidos;
+            while ((leidos = read(fd, bloque, sizeof(bloque))) > 0) buffer.append(bloque, leidos);
+            close(fd);
+            if (leidos < 0) return false;
+            datos = buffer.data();
+            tam = buffer.size();
+            return true;
+        }
+        tam = st.st_size;
+        if (tam > 0) {
+            mapa = mmap(nullptr, tam, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapa == MAP_FAILED) {
+                mapa = nullptr;
+                close(fd);
+                return false;
+            }
+            madvise(mapa, tam, MADV_SEQUENTIAL);
+            datos = static_cast<const char*>(mapa);
+        }
+        close(fd);
+        return true;
+#endif
+    }
+
+    ~ArchivoMapeado() {
+#ifndef _WIN32
+        if (mapa) munmap(mapa, tam);
+#endif
+    }
+
+private:
+    string buffer; // Contenido leído cuando no se puede mapear
+#ifndef _WIN32
+    void* mapa = nullptr;
+#endif
+};
+
+// Resultado de leer un trozo del archivo de entrada
+struct TrozoTraza {
+    TablaProcesos procesos;
+    size_t lineas = 0;     // Lineas completas o parciales que tiene el trozo
+    size_t lineaError = 0; // Linea (relativa al trozo, desde 1) del primer error; 0 si no hay
+    string error;          // Descripción del error
+};
+
+// Campos de un registro "etiqueta;BT;AT;Q;Pr" ya interpretado. La etiqueta
+// apunta dentro de la línea leída
+struct Registro {
+    string_view etiqueta;
+    long long BT = 0;
+    long long AT = 0;
+    int q = 0;
+    int pr = 0;
+};
+
+// Interpreta la línea [ini, fin) (sin el '\n'). Devuelve 1 si es un registro,
+// 0 si es una línea vacía o un comentario y -1 si está mal formada (en ese
+// caso deja la descripción en error)
+static int leerRegistro(const char* ini, const char* fin, Registro& reg, string& error) {
+    static const char* const campos[] = {"BT", "AT", "Q", "Pr"};
+
+    // Recortar espacios y '\r' de ambos extremos
+    const char* a = ini;
+    const char* b = fin;
+    while (a < b && (*a == ' ' || *a == '\t')) a++;
+    while (b > a && (b[-1] == ' ' || b[-1] == '\t' || b[-1] == '\r')) b--;
+    if (a == b || *a == '#') return 0;
+
+    const char* sep = static_cast<const char*>(memchr(a, ';', b - a));
+    const char* finEt = sep;
+    while (finEt && finEt > a && (finEt[-1] == ' ' || finEt[-1] == '\t')) finEt--;
+    if (!sep || finEt == a) {
+        error = "falta la etiqueta del proceso";
+        return -1;
+    }
+
+    // Campos numéricos: BT; AT; Q; Pr
+    long long valores[4];
+    const char* c = sep + 1;
+    for (int campo = 0; campo < 4; campo++) {
+        while (c < b && (*c == ' ' || *c == '\t')) c++;
+        if (c == b) {
+            error = string("falta el campo ") + campos[campo];
+            return -1;
+        }
+        auto [q, ec] = from_chars(c, b, valores[campo]);
+        while (q < b && (*q == ' ' || *q == '\t')) q++;
+        if (ec == errc() && campo < 3 && q == b) {
+            error = string("falta el campo ") + campos[campo + 1];
+            return -1;
+        }
+        // Tras Pr puede venir un ';' final (lo que siga se ignora)
+        bool separadorOk = campo < 3 ? (q < b && *q == ';') : (q == b || *q == ';');
+        if (ec != errc() || valores[campo] < 0 || !separadorOk ||
+            (campo >= 2 && valores[campo] > INT32_MAX)) {
+            error = string("valor no valido en el campo ") + campos[campo] +
+                    " (se esperaba un entero no negativo)";
+            return -1;
+        }
+        c = q + 1;
+    }
+    reg.etiqueta = string_view(a, finEt - a);
+    reg.BT = valores[0];
+    reg.AT = valores[1];
+    reg.q = (int)valores[2];
+    reg.pr = (int)valores[3];
+    return 1;
+}
+
+// Interpreta los registros "etiqueta;BT;AT;Q;Pr" de [ini, fin). El trozo
+// empieza al inicio de una línea y termina justo después de un '\n' (o al
+// final del archivo)
+static void leerTrozo(const char* ini, const char* fin, TrozoTraza& trozo) {
+    // Contar líneas para reservar la tabla de una sola vez
+    for (const char* p = ini; p < fin; p++) {
+        p = static_cast<const char*>(memchr(p, '\n', fin - p));
+        if (!p) break;
+        trozo.lineas++;
+    }
+    if (fin > ini && fin[-1] != '\n') trozo.lineas++;
+    trozo.procesos.reservar(trozo.lineas);
+
+    size_t numLinea = 0;
+    const char* p = ini;
+    Registro reg;
+    while (p < fin) {
+        const char* finLinea = static_cast<const char*>(memchr(p, '\n', fin - p));
+        if (!finLinea) finLinea = fin;
+        numLinea++;
+
+        int leido = leerRegistro(p, finLinea, reg, trozo.error);
+        p = finLinea < fin ? finLinea + 1 : fin;
+        if (leido == 0) continue;
+        if (leido < 0) {
+            trozo.lineaError = numLinea;
+            return;
+        }
+        trozo.procesos.agregar(string(reg.etiqueta), reg.BT, reg.AT, reg.q, reg.pr);
+    }
+}
+
+// Carga un archivo de trazas en la tabla de procesos. El archivo se mapea en
+// memoria y, si hilos > 1, se divide en trozos que se interpretan en paralelo.
+// Devuelve false e imprime la línea del primer registro mal formado si lo hay
+bool cargarTraza(const string& ruta, TablaProcesos& procesos, unsigned hilos) {
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(ruta)) {
+        cerr << "Error: no se pudo abrir " << ruta << endl;
+        return false;
+    }
+    const char* ini = archivo.datos;
+    const char* fin = archivo.datos + archivo.tam;
+
+    // Trozos de al menos 1 MB para que repartir valga la pena
+    const size_t minTrozo = 1 << 20;
+    if (hilos == 0) hilos = max(1u, thread::hardware_concurrency());
+    hilos = max<size_t>(1, min<size_t>(hilos, archivo.tam / minTrozo));
+
+    // Cortar los trozos justo después de un '\n'
+    vector<const char*> cortes{ini};
+    for (unsigned h = 1; h < hilos; h++) {
+        const char* c = ini + archivo.tam * h / hilos;
+        if (c < cortes.back()) c = cortes.back();
+        const char* nl = static_cast<const char*>(memchr(c, '\n', fin - c));
+        cortes.push_back(nl ? nl + 1 : fin);
+    }
+    cortes.push_back(fin);
+
+    vector<TrozoTraza> trozos(hilos);
+    if (hilos == 1) {
+        leerTrozo(ini, fin, trozos[0]);
+    } else {
+        vector<thread> trabajadores;
+        for (unsigned h = 0; h < hilos; h++) {
+            trabajadores.emplace_back(leerTrozo, cortes[h], cortes[h + 1], ref(trozos[h]));
+        }
+        for (auto& th : trabajadores) th.join();
+    }
+
+    // Reportar el primer error con su número de línea en el archivo
+    size_t lineaBase = 0;
+    size_t total = 0;
+    for (auto& trozo : trozos) {
+        if (trozo.lineaError) {
+            cerr << "Error: " << ruta << ":" << lineaBase + trozo.lineaError
+                 << ": registro mal formado: " << trozo.error << endl;
+            return false;
+        }
+        lineaBase += trozo.lineas;
+        total += trozo.procesos.size();
+    }
+
+    // Unir los trozos en orden
+    if (hilos == 1) {
+        procesos = move(trozos[0].procesos);
+    } else {
+        procesos.reservar(total);
+        for (auto& trozo : trozos) procesos.anexar(move(trozo.procesos));
+    }
+    return true;
+}
+
+// Llegadas leídas en línea de un flujo (por ejemplo stdin conectado a una
+// tubería), que debe traer los registros ordenados por tiempo de llegada.
+// Cada proceso ocupa un lugar de la tabla solo mientras está vivo: al
+// terminar se escribe su fila y el lugar se reutiliza, así que la memoria
+// depende de los procesos vivos y no del largo de la traza
+class FuenteEnLinea {
+public:
+    FuenteEnLinea(istream& in, ostream& out, TablaProcesos& t, EstadoProcesos& e, Scheduler& s)
+        : in(in), out(out), t(t), e(e), scheduler(s) {}
+
+    bool pendiente() {
+        if (!hayPendiente && !agotada) leerSiguiente();
+        return hayPendiente;
+    }
+    long long proxima() const { return reg.AT; }
+    long long proximaRafaga() const { return reg.BT; }
+
+    uint32_t tomar() {
+        uint32_t p;
+        if (!libres.empty()) {
+            // Reutilizar el lugar de un proceso ya terminado
+            p = libres.back();
+            libres.pop_back();
+            t.etiqueta[p] = etiqueta;
+            t.burst_time[p] = reg.BT;
+            t.arrival_time[p] = reg.AT;
+            t.cola[p] = reg.q;
+            t.priority[p] = reg.pr;
+        } else {
+            p = t.size();
+            t.agregar(etiqueta, reg.BT, reg.AT, reg.q, reg.pr);
+            scheduler.crecer(t.size());
+        }
+        e.iniciar(p, reg.BT);
+        hayPendiente = false;
+        recibidos++;
+        return p;
+    }
+
+    void terminar(uint32_t p, ResultadoMLFQ&) {
+        escribirFila(out, t, e, p);
+        libres.push_back(p);
+    }
+    uint32_t llegados() const { return recibidos; }
+
+    // Descripción del error que detuvo la lectura (vacía si no hubo)
+    const string& error() const { return mensajeError; }
+
+private:
+    istream& in;
+    ostream& out;
+    TablaProcesos& t;
+    EstadoProcesos& e;
+    Scheduler& scheduler;
+    vector<uint32_t> libres;    // Lugares de la tabla que se pueden reutilizar
+    Registro reg;               // Siguiente llegada (si hayPendiente)
+    string etiqueta;            // Copia de la etiqueta de reg
+    string linea;
+    bool hayPendiente = false;
+    bool agotada = false;       // Fin del flujo o error
+    size_t numLinea = 0;
+    uint32_t recibidos = 0;
+    long long ultimaLlegada = 0;
+    string mensajeError;
+
+    void leerSiguiente() {
+        while (true) {
+            // Si leer puede bloquear, entregar antes las filas ya terminadas
+            if (in.rdbuf()->in_avail() <= 0) out.flush();
+            if (!getline(in, linea)) {
+                agotada = true;
+                return;
+            }
+            numLinea++;
+            string error;
+            int leido = leerRegistro(linea.data(), linea.data() + linea.size(), reg, error);
+            if (leido == 0) continue;
+            if (leido > 0 && reg.AT < ultimaLlegada) {
+                leido = -1;
+                error = "llegada fuera de orden (" + to_string(reg.AT) + " < " +
+                        to_string(ultimaLlegada) + ")";
+            }
+            if (leido < 0) {
+                mensajeError = "stdin:" + to_string(numLinea) + ": registro mal formado: " + error;
+                agotada = true;
+                return;
+            }
+            ultimaLlegada = reg.AT;
+            etiqueta.assign(reg.etiqueta);
+            hayPendiente = true;
+            return;
+        }
+    }
+};
+
+// Modo en línea: simula las llegadas que van entrando por 'in' y escribe en
+// 'out' cada proceso en cuanto termina; al final escribe los promedios y
+// percentiles. Devuelve false si la entrada tenía un registro mal formado
+// (los procesos ya recibidos se simulan igual)
+bool MLFQEnLinea(istream& in, ostream& out, Scheduler& scheduler, const OpcionesMLFQ& opciones) {
+    TablaProcesos t;
+    EstadoProcesos e;
+    scheduler.preparar(t, e);
+    FuenteEnLinea fuente(in, out, t, e, scheduler);
+
+    out << "# etiqueta; BT; AT; Q; Pr; WT; CT; RT; TAT\n";
+    ResultadoMLFQ r = simularMLFQ(fuente, t, e, scheduler, opciones);
+    escribirResumen(out, r.metricas);
+    out.flush();
+
+    printContadores(r, opciones, cerr);
+    if (opciones.instrumentacion) printInstrumentacion(*opciones.instrumentacion, cerr);
+    cerr << "Procesos vivos a la vez (maximo): " << t.size() << endl;
+    if (!fuente.error().empty()) {
+        cerr << "Error: " << fuente.error() << endl;
+        return false;
+    }
+    return true;
+}
+
+// Generador pseudoaleatorio xoshiro256** sembrado con splitmix64. Las
+// distribuciones se calculan aquí (las de <random> cambian entre bibliotecas),
+// así que la misma semilla da la misma traza en cualquier plataforma
+class Aleatorio {
+public:
+    explicit Aleatorio(uint64_t semilla) {
+        for (uint64_t& s : estado) {
+            semilla += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = semilla;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            s = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t siguiente() {
+        uint64_t resultado = rotar(estado[1] * 5, 7) * 9;
+        uint64_t t = estado[1] << 17;
+        estado[2] ^= estado[0];
+        estado[3] ^= estado[1];
+        estado[1] ^= estado[2];
+        estado[0] ^= estado[3];
+        estado[2] ^= t;
+        estado[3] = rotar(estado[3], 45);
+        return resultado;
+    }
+
+    // Uniforme en (0, 1]
+    double uniforme() { return ((siguiente() >> 11) + 1) * (1.0 / 9007199254740992.0); }
+    // Entero uniforme en [a, b]
+    long long entero(long long a, long long b) {
+        return a + (long long)(siguiente() % (uint64_t)(b - a + 1));
+    }
+    double exponencial(double media) { return -media * log(uniforme()); }
+    // Pareto con la media pedida (alfa > 1): cola pesada, pocos valores enormes
+    double pareto(double media, double alfa) {
+        double xm = media * (alfa - 1) / alfa;
+        return xm / pow(uniforme(), 1 / alfa);
+    }
+
+private:
+    uint64_t estado[4];
+    static uint64_t rotar(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Parámetros de una carga sintética
+struct ParametrosCarga {
+    uint64_t semilla = 1;
+    size_t procesos = 1000;
+    string llegadas = "poisson"; // poisson, rafagas (fases activas y calmadas) o diurna
+    double tasa = 0.1;           // Llegadas promedio por unidad de tiempo
+    double periodo = 10000;      // Periodo del ciclo diurno / duración media de dos fases de ráfagas
+    string bt = "pareto";        // Distribución del burst time: exp o pareto
+    double btMedio = 10;         // Burst time medio
+    double alfa = 1.5;           // Forma de la Pareto (> 1; cuanto menor, más pesada la cola)
+    int colas = 4;               // Q va de 1 a colas
+};
+
+// Llena la tabla con una carga sintética ya ordenada por llegada
+void generarCarga(const ParametrosCarga& c, TablaProcesos& t) {
+    const double k = 10;         // Razón entre la tasa activa y la calmada en modo ráfagas
+    const double amplitud = 0.8; // Variación de la tasa en el ciclo diurno
+    const double pi = acos(-1.0);
+    const double btMaximo = 1e12;
+
+    Aleatorio rng(c.semilla);
+    t = TablaProcesos();
+    t.reservar(c.procesos);
+    double reloj = 0;
+    bool activa = true;
+    double finFase = rng.exponencial(c.periodo / 2);
+    for (size_t i = 0; i < c.procesos; i++) {
+        if (c.llegadas == "rafagas") {
+            // Poisson modulado: la tasa promedio sigue siendo c.tasa
+            while (true) {
+                double tasa = activa ? 2 * c.tasa * k / (k + 1) : 2 * c.tasa / (k + 1);
+                double paso = rng.exponencial(1 / tasa);
+                if (reloj + paso <= finFase) {
+                    reloj += paso;
+                    break;
+                }
+                // Sin memoria: se puede descartar el paso y seguir desde el cambio de fase
+                reloj = finFase;
+                activa = !activa;
+                finFase = reloj + rng.exponencial(c.periodo / 2);
+            }
+        } else if (c.llegadas == "diurna") {
+            // Poisson no homogéneo por adelgazamiento con tasa c.tasa * (1 + a sen(2πt / periodo))
+            double tasaMax = c.tasa * (1 + amplitud);
+            do {
+                reloj += rng.exponencial(1 / tasaMax);
+            } while (rng.uniforme() * tasaMax > c.tasa * (1 + amplitud * sin(2 * pi * reloj / c.periodo)));
+        } else {
+            reloj += rng.exponencial(1 / c.tasa);
+        }
+
+        double bt = c.bt == "exp" ? rng.exponencial(c.btMedio) : rng.pareto(c.btMedio, c.alfa);
+        long long BT = max(1LL, (long long)llround(min(bt, btMaximo)));
+        int q = (int)rng.entero(1, c.colas);
+        int pr = (int)rng.entero(1, 5);
+        t.agregar("P" + to_string(i + 1), BT, (long long)reloj, q, pr);
+    }
+}
+
+// Escribe la tabla en el formato de entrada "etiqueta;BT;AT;Q;Pr"
+bool escribirTraza(const string& ruta, const TablaProcesos& t, const ParametrosCarga& c) {
+    ofstream out(ruta, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        cerr << "Error: no se pudo crear " << ruta << endl;
+        return false;
+    }
+    out << "# generado: semilla=" << c.semilla << " procesos=" << c.procesos
+        << " llegadas=" << c.llegadas << " tasa=" << c.tasa << " periodo=" << c.periodo
+        << " bt=" << c.bt << " bt-medio=" << c.btMedio << " alfa=" << c.alfa << "\n";
+    out << "# etiqueta; burst time (BT); arrival time (AT);Queue (Q);Priority(5>1)\n";
+
+    // Las líneas se arman en un buffer y se escriben en bloques de 1 MB
+    vector<char> buffer(1 << 20);
+    size_t usado = 0;
+    for (uint32_t p = 0; p < t.size(); p++) {
+        if (buffer.size() - usado < t.etiqueta[p].size() + 5 * 21) {
+            out.write(buffer.data(), usado);
+            usado = 0;
+        }
+        char* c = buffer.data() + usado;
+        char* fin = buffer.data() + buffer.size();
+        c = copy(t.etiqueta[p].begin(), t.etiqueta[p].end(), c);
+        *c++ = ';';
+        c = to_chars(c, fin, t.burst_time[p]).ptr;
+        *c++ = ';';
+        c = to_chars(c, fin, t.arrival_time[p]).ptr;
+        *c++ = ';';
+        c = to_chars(c, fin, t.cola[p]).ptr;
+        *c++ = ';';
+        c = to_chars(c, fin, t.priority[p]).ptr;
+        *c++ = '\n';
+        usado = c - buffer.data();
+    }
+    out.write(buffer.data(), usado);
+    out.close();
+    if (!out) {
+        cerr << "Error: no se pudo escribir " << ruta << endl;
+        return false;
+    }
+    return true;
+}
+
+// Memoria residente máxima del proceso en MB (0 si no se puede medir)
+double rssPicoMB() {
+#ifndef _WIN32
+    struct rusage uso;
+    if (getrusage(RUSAGE_SELF, &uso) == 0) {
+#ifdef __APPLE__
+        return uso.ru_maxrss / (1024.0 * 1024.0); // macOS lo da en bytes
+#else
+        return uso.ru_maxrss / 1024.0;            // Linux lo da en KB
+#endif
+    }
+#endif
+    return 0;
+}
+
+// Interpreta todo [ini, fin) como un número; false si está vacío, sobra
+// texto o no cabe en el tipo
+template <typename T>
+bool leerNumero(const char* ini, const char* fin, T& valor) {
+    auto [p, ec] = from_chars(ini, fin, valor);
+    return ec == errc() && p == fin && ini != fin;
+}
+template <typename T>
+bool leerNumero(const string& s, T& valor) {
+    return leerNumero(s.data(), s.data() + s.size(), valor);
+}
+
+// Añade al scheduler las colas descritas en 'colas' ("TIPO:Q,TIPO:Q,...")
+bool crearColas(Scheduler& scheduler, const string& colas) {
+    stringstream ssColas(colas);
+    string nivel;
+    while (getline(ssColas, nivel, ',')) {
+        size_t dosPuntos = nivel.find(':');
+        string tipo = nivel.substr(0, dosPuntos);
+        int quantum = 0;
+        bool quantumOk = dosPuntos == string::npos || leerNumero(nivel.substr(dosPuntos + 1), quantum);
+        if (!quantumOk || quantum < 0 || !scheduler.add_queue(scheduler.queues.size(), tipo, quantum)) {
+            cerr << "Error: cola no valida '" << nivel << "'" << endl;
+            return false;
+        }
+    }
+    if (scheduler.queues.empty()) {
+        cerr << "Error: se necesita al menos una cola" << endl;
+        return false;
+    }
+    return true;
+}
+
+// Mide MLFQ sobre cargas sintéticas de 'minimo' a 'maximo' procesos
+// (multiplicando por 10). Solo se cronometra la simulación; la carga se
+// genera antes y la salida por proceso se omite
+void benchmarkMLFQ(ParametrosCarga carga, size_t minimo, size_t maximo, const string& colas,
+                   OpcionesMLFQ opciones) {
+    opciones.detalle = false;
+    cout << "# procesos; generar (s); simular (s); procesos/s; RSS pico (MB)" << endl;
+    for (size_t n = minimo; n <= maximo; n *= 10) {
+        carga.procesos = n;
+        TablaProcesos t;
+        auto t0 = chrono::steady_clock::now();
+        generarCarga(carga, t);
+        auto t1 = chrono::steady_clock::now();
+
+        Scheduler scheduler;
+        crearColas(scheduler, colas);
+        EstadoProcesos estado;
+        ResultadoMLFQ r = MLFQ(t, estado, scheduler, opciones);
+        auto t2 = chrono::steady_clock::now();
+
+        double generar = chrono::duration<double>(t1 - t0).count();
+        double simular = chrono::duration<double>(t2 - t1).count();
+        cout << n << "; " << fixed << setprecision(4) << generar << "; " << simular << "; "
+             << setprecision(0) << (simular > 0 ? n / simular : 0.0) << "; "
+             << setprecision(1) << rssPicoMB() << defaultfloat << endl;
+        if (r.metricas.TAT.cantidad() != (long long)n) {
+            cerr << "Error: se completaron " << r.metricas.TAT.cantidad() << " de " << n << " procesos" << endl;
+        }
+        if (n > maximo / 10) break; // Evitar desbordar n *= 10
+    }
 }
 
 int main(int argc, char* argv[]) {
     // Verificar argumentos
     if (argc < 2) {
-        cerr << "Uso: " << argv[0] << " <archivo_entrada>" << endl;
+        cerr << "Uso: " << argv[0] << " [--] <archivo_entrada | -> [--hilos N] [--colas TIPO:Q,...] [--preemptivo]" << endl;
+        cerr << "           [--boost S] [--envejecimiento A]" << endl;
+        cerr << "           [--nucleos N] [--umbral-robo K] [--costo-migracion M]" << endl;
+        cerr << "           [--barrido-niveles MIN-MAX] [--barrido-quantums Q1,Q2,...] [--barrido-orden WT|TAT|RT]" << endl;
+        cerr << "           [--sin-detalle] [--instrumentar] [--timeline RUTA]" << endl;
+        cerr << "           [--checkpoint T RUTA | --checkpoint-cada P RUTA] [--solo-checkpoint] [--restaurar RUTA]" << endl;
+        cerr << "  TIPO: RR, FCFS, SJF, SRTF o PR (prioridad); Q = quantum, 0 = sin limite" << endl;
+        cerr << "  SRTF en el primer nivel expropia cuando llega un proceso mas corto (con un nucleo);" << endl;
+        cerr << "  en los demas niveles y con --nucleos solo ordena por el tiempo restante" << endl;
+        cerr << "  --hilos: hilos para leer la traza y para el barrido (0 = todos, por defecto)" << endl;
+        cerr << "  '-' lee las llegadas en linea de stdin (ordenadas por AT) y escribe en stdout" << endl;
+        cerr << "  cada proceso en cuanto termina. Una traza que se llame como un modo (generar," << endl;
+        cerr << "  benchmark) o '-' se pasa como ./generar o despues de --" << endl;
+        cerr << "  --instrumentar: pedazos, tiempo de CPU, degradaciones y profundidad de cada nivel" << endl;
+        cerr << "  --timeline: escribe los eventos (tiempo, pid, nivel, evento) en un archivo binario" << endl;
+        cerr << "  --checkpoint: guarda el estado de la simulacion al llegar a T (o cada P unidades);" << endl;
+        cerr << "  --restaurar lo continua, sobre la misma traza y politicas, con las demas opciones libres" << endl;
+        cerr << "   o: " << argv[0] << " generar <archivo_salida> [opciones de carga]" << endl;
+        cerr << "   o: " << argv[0] << " benchmark [--min N] [--max N] [opciones de carga] [--colas ...] [--preemptivo]" << endl;
+        cerr << "  Opciones de carga: [--procesos N] [--semilla S] [--llegadas poisson|rafagas|diurna]" << endl;
+        cerr << "           [--tasa L] [--periodo P] [--bt exp|pareto] [--bt-medio B] [--alfa A] [--num-colas C]" << endl;
+        return 1;
+    }
+    // El primer argumento es el modo o la traza; tras "--" siempre es la traza
+    int primero = string(argv[1]) == "--" ? 2 : 1;
+    if (primero >= argc) {
+        cerr << "Error: falta el archivo de entrada despues de --" << endl;
+        return 1;
+    }
+    string modo = primero == 1 ? argv[1] : "";
+    const char* traza = argv[primero];
+    if (modo == "generar" && argc < 3) {
+        cerr << "Error: falta el archivo de salida de generar" << endl;
         return 1;
     }
 
-    ifstream archivo(argv[1]);
-    if (!archivo.is_open()) {
-        cerr << "Error: no se pudo abrir " << argv[1] << endl;
+    // Opciones
+    unsigned hilos = 0; // Hilos para leer la traza y para el barrido (0 = todos los disponibles)
+    string colas = "RR:3,RR:5,RR:6,RR:20"; // Política y quantum de cada nivel
+    OpcionesMLFQ opciones;
+    bool barrido = false;
+    string barridoNiveles = "2-4";
+    string barridoQuantums = "2,4,8,16";
+    string barridoOrden = "WT";
+    bool instrumentar = false;
+    string rutaTimeline;
+    string rutaRestaurar;
+    ParametrosCarga carga;          // Para generar y benchmark
+    bool opcionesCarga = false;
+    size_t benchMin = 1000, benchMax = 10000000;
+    for (int a = modo == "generar" ? 3 : primero + 1; a < argc; a++) {
+        string opcion = argv[a];
+        // Lee el valor numérico que sigue a la opción; false (con el error ya
+        // impreso) si no es un número completo del tipo de 'valor'
+        auto numero = [&](auto& valor) {
+            if (leerNumero(string(argv[++a]), valor)) return true;
+            cerr << "Error: valor no valido para " << opcion << endl;
+            return false;
+        };
+        if (opcion == "--hilos" && a + 1 < argc) {
+            if (!numero(hilos)) return 1;
+        } else if (opcion == "--colas" && a + 1 < argc) {
+            colas = argv[++a];
+        } else if (opcion == "--preemptivo") {
+            opciones.preemptivo = true;
+        } else if (opcion == "--boost" && a + 1 < argc) {
+            if (!numero(opciones.boost)) return 1;
+        } else if (opcion == "--envejecimiento" && a + 1 < argc) {
+            if (!numero(opciones.envejecimiento)) return 1;
+        } else if (opcion == "--nucleos" && a + 1 < argc) {
+            if (!numero(opciones.nucleos)) return 1;
+        } else if (opcion == "--umbral-robo" && a + 1 < argc) {
+            if (!numero(opciones.umbralRobo)) return 1;
+        } else if (opcion == "--costo-migracion" && a + 1 < argc) {
+            if (!numero(opciones.costoMigracion)) return 1;
+        } else if (opcion == "--barrido-niveles" && a + 1 < argc) {
+            barrido = true;
+            barridoNiveles = argv[++a];
+        } else if (opcion == "--barrido-quantums" && a + 1 < argc) {
+            barrido = true;
+            barridoQuantums = argv[++a];
+        } else if (opcion == "--sin-detalle") {
+            opciones.detalle = false;
+        } else if (opcion == "--checkpoint" && a + 2 < argc) {
+            if (!numero(opciones.checkpointEn)) return 1;
+            opciones.checkpointCada = 0;
+            opciones.rutaCheckpoint = argv[++a];
+        } else if (opcion == "--checkpoint-cada" && a + 2 < argc) {
+            if (!numero(opciones.checkpointCada)) return 1;
+            if (opciones.checkpointCada == 0) opciones.checkpointCada = -1; // No válido
+            opciones.checkpointEn = opciones.checkpointCada;
+            opciones.rutaCheckpoint = argv[++a];
+        } else if (opcion == "--solo-checkpoint") {
+            opciones.soloCheckpoint = true;
+        } else if (opcion == "--restaurar" && a + 1 < argc) {
+            rutaRestaurar = argv[++a];
+        } else if (opcion == "--procesos" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.procesos)) return 1;
+        } else if (opcion == "--semilla" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.semilla)) return 1;
+        } else if (opcion == "--llegadas" && a + 1 < argc) {
+            opcionesCarga = true;
+            carga.llegadas = argv[++a];
+        } else if (opcion == "--tasa" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.tasa)) return 1;
+        } else if (opcion == "--periodo" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.periodo)) return 1;
+        } else if (opcion == "--bt" && a + 1 < argc) {
+            opcionesCarga = true;
+            carga.bt = argv[++a];
+        } else if (opcion == "--bt-medio" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.btMedio)) return 1;
+        } else if (opcion == "--alfa" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.alfa)) return 1;
+        } else if (opcion == "--num-colas" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(carga.colas)) return 1;
+        } else if (opcion == "--min" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(benchMin)) return 1;
+        } else if (opcion == "--max" && a + 1 < argc) {
+            opcionesCarga = true;
+            if (!numero(benchMax)) return 1;
+        } else if (opcion == "--instrumentar") {
+            instrumentar = true;
+        } else if (opcion == "--timeline" && a + 1 < argc) {
+            instrumentar = true;
+            rutaTimeline = argv[++a];
+        } else if (opcion == "--barrido-orden" && a + 1 < argc) {
+            barridoOrden = argv[++a];
+        } else {
+            cerr << "Error: opcion desconocida " << opcion << endl;
+            return 1;
+        }
+    }
+    if (opciones.nucleos < 1 || opciones.umbralRobo < 1 || opciones.costoMigracion < 0) {
+        cerr << "Error: --nucleos y --umbral-robo deben ser >= 1 y --costo-migracion >= 0" << endl;
+        return 1;
+    }
+    if (opciones.nucleos > 1 && opciones.preemptivo) {
+        cerr << "Error: --preemptivo solo esta disponible con un nucleo" << endl;
         return 1;
     }
 
-    // Leer procesos del archivo y guardarlos todos en un vector
-    vector<proceso> procesos;
-    string linea;
-    while (getline(archivo, linea)) {
-        if (linea.empty() || linea[0] == '#') continue;
-        stringstream ss(linea);
-        string campo;
+    // Puntos de control (solo con un núcleo, sin barrido y con una traza en archivo)
+    bool conCheckpoint = !opciones.rutaCheckpoint.empty() || !rutaRestaurar.empty();
+    if (opciones.checkpointEn < -1 || opciones.checkpointCada < 0 ||
+        (opciones.rutaCheckpoint.empty() && opciones.soloCheckpoint)) {
+        cerr << "Error: --checkpoint necesita T >= 0, --checkpoint-cada P > 0 y --solo-checkpoint uno de ellos" << endl;
+        return 1;
+    }
+    if (conCheckpoint && (opciones.nucleos > 1 || barrido || modo == "-")) {
+        cerr << "Error: los puntos de control solo estan disponibles con un nucleo, sin barrido y con archivo de entrada" << endl;
+        return 1;
+    }
+
+    // Instrumentación por nivel y línea de tiempo (solo con un núcleo y sin barrido)
+    Instrumentacion instrumentacion;
+    EscritorTimeline timeline;
+    if (instrumentar) {
+        if (opciones.nucleos > 1 || barrido) {
+            cerr << "Error: --instrumentar y --timeline solo estan disponibles con un nucleo y sin barrido" << endl;
+            return 1;
+        }
+        if (!rutaTimeline.empty()) {
+            if (!timeline.abrir(rutaTimeline)) {
+                cerr << "Error: no se pudo crear " << rutaTimeline << endl;
+                return 1;
+            }
+            instrumentacion.timeline = &timeline;
+        }
+        opciones.instrumentacion = &instrumentacion;
+    }
+
+    // Generador de cargas sintéticas y benchmark
+    if (modo == "generar" || modo == "benchmark") {
+        if ((carga.llegadas != "poisson" && carga.llegadas != "rafagas" && carga.llegadas != "diurna") ||
+            (carga.bt != "exp" && carga.bt != "pareto") || !(carga.tasa > 0) || !(carga.periodo > 0) ||
+            !(carga.btMedio > 0) || !(carga.alfa > 1) || carga.colas < 1 || carga.procesos == 0 ||
+            carga.procesos > UINT32_MAX - 1 || benchMin == 0 || benchMax < benchMin || benchMax > UINT32_MAX - 1) {
+            cerr << "Error: opciones de carga no validas" << endl;
+            return 1;
+        }
+        if (modo == "generar") {
+            TablaProcesos t;
+            generarCarga(carga, t);
+            return escribirTraza(argv[2], t, carga) ? 0 : 1;
+        }
+        if (opciones.nucleos > 1 || barrido || instrumentar || conCheckpoint) {
+            cerr << "Error: el benchmark solo admite las opciones de MLFQ de un nucleo" << endl;
+            return 1;
+        }
+        Scheduler prueba;
+        if (!crearColas(prueba, colas)) return 1;
+        benchmarkMLFQ(carga, benchMin, benchMax, colas, opciones);
+        return 0;
+    }
+    if (opcionesCarga) {
+        cerr << "Error: las opciones de carga solo se usan con generar o benchmark" << endl;
+        return 1;
+    }
+
+    // Modo en línea: las llegadas vienen de stdin y los procesos se entregan al terminar
+    if (modo == "-") {
+        if (opciones.nucleos > 1 || barrido) {
+            cerr << "Error: la entrada en linea no admite --nucleos ni barrido" << endl;
+            return 1;
+        }
+        Scheduler scheduler;
+        if (!crearColas(scheduler, colas)) return 1;
+        ios::sync_with_stdio(false);
+        return MLFQEnLinea(cin, cout, scheduler, opciones) ? 0 : 1;
+    }
 
-        getline(ss, campo, ';'); string et = campo;
-        getline(ss, campo, ';'); int BT = stoi(campo);
-        getline(ss, campo, ';'); int AT = stoi(campo);
-        getline(ss, campo, ';'); int q = stoi(campo);
-        getline(ss, campo, ';'); int p = stoi(campo);
+    // Leer procesos del archivo y guardarlos todos en la tabla
+    TablaProcesos procesos;
+    if (!cargarTraza(traza, procesos, hilos)) return 1;
+    if (procesos.size() == 0) {
+        cerr << "Error: " << traza << " no tiene procesos" << endl;
+        return 1;
+    }
+    procesos.ordenarPorLlegada();
 
-        procesos.emplace_back(et, BT, AT, q, p);
+    // Modo barrido: todas las configuraciones sobre la misma traza ya cargada
+    if (barrido) {
+        int nivelesMin = 0, nivelesMax = 0;
+        size_t guion = barridoNiveles.find('-');
+        bool nivelesOk = leerNumero(barridoNiveles.substr(0, guion), nivelesMin);
+        if (guion == string::npos) nivelesMax = nivelesMin;
+        else nivelesOk = nivelesOk && leerNumero(barridoNiveles.substr(guion + 1), nivelesMax);
+        vector<int> quantums;
+        stringstream ssQuantums(barridoQuantums);
+        string q;
+        bool quantumsOk = true;
+        while (getline(ssQuantums, q, ',')) {
+            int quantum = 0;
+            quantumsOk = quantumsOk && leerNumero(q, quantum);
+            quantums.push_back(quantum);
+        }
+        if (!nivelesOk || !quantumsOk || nivelesMin < 1 || nivelesMax < nivelesMin || quantums.empty() ||
+            *min_element(quantums.begin(), quantums.end()) < 0) {
+            cerr << "Error: barrido no valido (niveles " << barridoNiveles
+                 << ", quantums " << barridoQuantums << ")" << endl;
+            return 1;
+        }
+        if (barridoOrden != "WT" && barridoOrden != "TAT" && barridoOrden != "RT") {
+            cerr << "Error: --barrido-orden debe ser WT, TAT o RT" << endl;
+            return 1;
+        }
+        if (opciones.nucleos > 1) {
+            cerr << "Error: el barrido solo esta disponible con un nucleo" << endl;
+            return 1;
+        }
+        return barridoMLFQ(procesos, opciones, nivelesMin, nivelesMax, quantums, hilos, barridoOrden) ? 0 : 1;
     }
 
     // Crear el scheduler y añadir las colas con sus políticas y quantums
     Scheduler scheduler;
-    scheduler.add_queue(0, "RR", 3);
-    scheduler.add_queue(1, "RR", 5);
-    scheduler.add_queue(2, "RR", 6);
-    scheduler.add_queue(3, "RR", 20);
+    if (!crearColas(scheduler, colas)) return 1;
 
     // Ejecutar el algoritmo MLFQ
-    MLFQ(procesos, scheduler);
+    EstadoProcesos estado;
+    ResultadoMLFQ r;
+    if (!rutaRestaurar.empty()) {
+        if (!MLFQDesdePuntoControl(rutaRestaurar, procesos, estado, scheduler, opciones, r)) return 1;
+    } else {
+        r = opciones.nucleos > 1 ? MLFQMultinucleo(procesos, estado, scheduler, opciones)
+                                 : MLFQ(procesos, estado, scheduler, opciones);
+    }
+    if (r.interrumpido) {
+        cout << "Simulacion detenida en el punto de control " << opciones.rutaCheckpoint << endl;
+        return r.checkpoints > 0 ? 0 : 1;
+    }
+    if (!opciones.rutaCheckpoint.empty()) {
+        if (r.checkpoints == 0 && opciones.soloCheckpoint) {
+            cerr << "Error: la simulacion termino antes del punto de control" << endl;
+            return 1;
+        }
+        if (r.checkpoints == 0) cerr << "Aviso: la simulacion termino antes del punto de control" << endl;
+        else cout << "Puntos de control guardados: " << r.checkpoints << endl;
+    }
+
+    // Imprimir resultados
+    printResultados(procesos, estado, r.resp, r.metricas);
+    printContadores(r, opciones);
+    printNucleos(r);
+    if (opciones.instrumentacion) printInstrumentacion(instrumentacion);
     return 0;
 }
@@ -6,6 +6,9 @@
 #include <list>
 #include <sstream>
 #include <map>
+#include <unordered_map>
+#include <set>
+#include <algorithm>
 
 using namespace std;
 
@@ -19,10 +22,11 @@ public:
     int size;            // Tamaño del bloque en unidades de memoria
     bool is_free;        // true = bloque libre, false = bloque ocupado
     string process_id;   // ID del proceso que ocupa el bloque (vacío si está libre)
+    int start;           // Dirección de inicio del bloque (usado en dinámico)
 
     // Constructor: inicializa un bloque de memoria
-    MemoryBlock(int i, int s, bool free = true, const string& p_id = "")
-        : id(i), size(s), is_free(free), process_id(p_id) {}
+    MemoryBlock(int i, int s, bool free = true, const string& p_id = "", int st = 0)
+        : id(i), size(s), is_free(free), process_id(p_id), start(st) {}
 };
 
 
@@ -31,41 +35,84 @@ public:
 
 class MemoryManager {
 private:
+    // Handle de un bloque del dinámico: iterador estable a su nodo en la lista
+    using BlockHandle = list<MemoryBlock>::iterator;
+
     // --- Estructuras de datos para almacenar la memoria ---
     list<MemoryBlock> dynamic_memory_;    // Lista enlazada para particionamiento dinámico
     vector<MemoryBlock> fixed_memory_;    // Vector para particionamiento fijo
+
+    // Índice de los bloques libres del dinámico ordenado por (tamaño, inicio):
+    // Best Fit es un lower_bound y Worst Fit sale del final. El inicio desempata
+    // igual que el recorrido de la lista (gana el bloque de menor dirección)
+    multimap<pair<int, int>, BlockHandle> free_blocks_by_size_;
+
+    // Índice process_id -> bloques del dinámico, para liberar sin recorrer la lista
+    unordered_map<string, vector<BlockHandle>> dynamic_blocks_by_process_;
+
+    // --- Sistema buddy ---
+    // La memoria se parte en regiones de potencia de 2 (de mayor a menor, así
+    // cada región queda alineada a su tamaño). Un bloque de orden k mide 2^k
+    vector<set<int>> buddy_free_lists_;          // Orden k -> inicios de los bloques libres
+    vector<vector<bool>> buddy_free_bitmap_;     // Orden k, inicio >> k -> ¿libre? (busca al buddy en O(1))
+    map<int, int> buddy_regions_;                // Inicio de región -> orden de la región
+    map<int, pair<int, string>> buddy_allocated_;  // Inicio -> (orden, proceso) de los bloques ocupados
+    unordered_map<string, vector<int>> buddy_blocks_by_process_;  // process_id -> inicios de sus bloques
     
     // --- Variables de configuración ---
     map<string, int> process_sizes_;      // Mapa: process_id -> tamaño real del proceso
-    string partition_scheme_str;          // "DYNAMIC" o "FIXED"
+    string partition_scheme_str;          // "DYNAMIC", "FIXED" o "BUDDY"
     int total_memory_size_;               // Tamaño total de la memoria disponible
     int next_block_id_;                   // ID para el siguiente bloque (usado en dinámico)
     int allocation_algorithm_;            // 1: First Fit, 2: Best Fit, 3: Worst Fit
 
     // ========================================================================
-    // MÉTODO: mergeFreeBlocks
-    // Fusiona bloques de memoria libres contiguos en particionamiento dinámico
-    // Esto ayuda a reducir la fragmentación externa
+    // MÉTODOS: addFreeBlock / removeFreeBlock
+    // Mantienen el índice de bloques libres al liberar, dividir o fusionar
     // ========================================================================
-    void mergeFreeBlocks() {
-        // Si hay menos de 2 bloques, no hay nada que fusionar
-        if (dynamic_memory_.size() < 2) return;
-        
-        // Iterar sobre la lista de bloques
-        list<MemoryBlock>::iterator it = dynamic_memory_.begin();
-        while (it != dynamic_memory_.end() && next(it) != dynamic_memory_.end()) {
-            list<MemoryBlock>::iterator next_it = next(it);
-            
-            // Si el bloque actual y el siguiente están libres, fusionarlos
-            if (it->is_free && next_it->is_free) {
-                it->size += next_it->size;  // Sumar el tamaño del siguiente al actual
-                dynamic_memory_.erase(next_it);  // Eliminar el siguiente bloque
-            } else {
-                ++it;  // Avanzar al siguiente bloque
+    void addFreeBlock(BlockHandle block) {
+        free_blocks_by_size_.emplace(make_pair(block->size, block->start), block);
+    }
+
+    void removeFreeBlock(BlockHandle block) {
+        auto range = free_blocks_by_size_.equal_range(make_pair(block->size, block->start));
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == block) {
+                free_blocks_by_size_.erase(it);
+                return;
             }
         }
     }
 
+    // ========================================================================
+    // MÉTODO: releaseBlock
+    // Libera un bloque del dinámico y lo fusiona solo con sus vecinos
+    // inmediatos (como con etiquetas de frontera). Como nunca quedan dos
+    // libres contiguos, esto equivale a fusionar toda la lista y no depende
+    // de cuántos bloques haya
+    // ========================================================================
+    void releaseBlock(BlockHandle block) {
+        block->is_free = true;        // Marcar como libre
+        block->process_id = "";       // Limpiar ID del proceso
+
+        // Fusionar con el bloque anterior si está libre (el anterior absorbe a este)
+        if (block != dynamic_memory_.begin() && prev(block)->is_free) {
+            BlockHandle previous = prev(block);
+            removeFreeBlock(previous);
+            previous->size += block->size;
+            dynamic_memory_.erase(block);
+            block = previous;
+        }
+        // Fusionar con el bloque siguiente si está libre
+        BlockHandle following = next(block);
+        if (following != dynamic_memory_.end() && following->is_free) {
+            removeFreeBlock(following);
+            block->size += following->size;
+            dynamic_memory_.erase(following);
+        }
+        addFreeBlock(block);
+    }
+
     // ========================================================================
     // MÉTODO: printShellFormat
     // Muestra el mapa de memoria en formato visual
@@ -84,6 +131,21 @@ private:
                         cout << "[" + block.process_id + ":" << process_sizes_[block.process_id] << "]";
                 }
             }
+        } else if (partition_scheme_str == "BUDDY") {
+            // Juntar bloques libres y ocupados en orden de dirección
+            map<int, string> blocks;  // Inicio -> texto del bloque
+            for (size_t k = 0; k < buddy_free_lists_.size(); ++k) {
+                for (int start : buddy_free_lists_[k]) {
+                    blocks[start] = "[Libre:" + to_string(1 << k) + "]";
+                }
+            }
+            for (const auto& entry : buddy_allocated_) {
+                const string& process_id = entry.second.second;
+                blocks[entry.first] = "[" + process_id + ":" + to_string(process_sizes_[process_id]) + "]";
+            }
+            for (const auto& entry : blocks) {
+                cout << entry.second;
+            }
         } else { // FIXED
             // Imprimir particiones fijas
             for (const MemoryBlock& block : fixed_memory_) {
@@ -119,6 +181,23 @@ private:
             cout << "  - Fragmentacion Interna: 0" << endl;
             cout << "  - Fragmentacion Externa:" << external_fragmentation << endl;
             
+        } else if (partition_scheme_str == "BUDDY") {
+            int total_internal_fragmentation = 0;
+            int total_free_memory_buddy = 0;
+
+            // Fragmentación interna: lo que sobra en cada bloque al redondear
+            // el proceso a una potencia de 2
+            for (const auto& entry : buddy_allocated_) {
+                total_internal_fragmentation += (1 << entry.second.first) - process_sizes_[entry.second.second];
+            }
+            // Fragmentación externa: memoria libre total en las listas
+            for (size_t k = 0; k < buddy_free_lists_.size(); ++k) {
+                total_free_memory_buddy += (int)buddy_free_lists_[k].size() << k;
+            }
+
+            cout << "  - Fragmentacion Interna Total: " << total_internal_fragmentation << endl;
+            cout << "  - Fragmentacion Externa: " << total_free_memory_buddy << endl;
+
         } else { // FIXED
             int total_internal_fragmentation = 0;
             int total_free_memory_fix = 0;
@@ -149,6 +228,8 @@ private:
     void allocate(const string& process_id, int process_size) {
         if (partition_scheme_str == "DYNAMIC") {
             allocateDynamic(process_id, process_size);
+        } else if (partition_scheme_str == "BUDDY") {
+            allocateBuddy(process_id, process_size);
         } else {
             allocateFixed(process_id, process_size);
         }
@@ -162,6 +243,8 @@ private:
     void liberate(const string& process_id) {
         if (partition_scheme_str == "DYNAMIC") {
             liberateDynamic(process_id);
+        } else if (partition_scheme_str == "BUDDY") {
+            liberateBuddy(process_id);
         } else {
             liberateFixed(process_id);
         }
@@ -171,9 +254,10 @@ private:
     // MÉTODO: allocateDynamic
     // Asigna memoria a un proceso en particionamiento dinámico
     // Implementa los algoritmos First Fit, Best Fit y Worst Fit
+    // Devuelve el handle del bloque asignado (end() si no hubo espacio)
     // ========================================================================
-    void allocateDynamic(const string& process_id, int process_size) {
-        list<MemoryBlock>::iterator block_to_use = dynamic_memory_.end();
+    BlockHandle allocateDynamic(const string& process_id, int process_size) {
+        BlockHandle block_to_use = dynamic_memory_.end();
         
         // --- FIRST FIT: Usar el primer bloque que sea suficientemente grande ---
         if (allocation_algorithm_ == 1) {
@@ -185,24 +269,20 @@ private:
             }
         } 
         // --- BEST FIT: Usar el bloque más pequeño que sea suficientemente grande ---
+        // (el primero del índice con tamaño >= process_size)
         else if (allocation_algorithm_ == 2) {
-            int min_diff = numeric_limits<int>::max();  // Diferencia mínima inicializada al máximo
-            
-            for (auto it = dynamic_memory_.begin(); it != dynamic_memory_.end(); ++it) {
-                if (it->is_free && it->size >= process_size && (it->size - process_size < min_diff)) {
-                    min_diff = it->size - process_size;  // Actualizar diferencia mínima
-                    block_to_use = it;
-                }
+            auto found = free_blocks_by_size_.lower_bound(make_pair(process_size, numeric_limits<int>::min()));
+            if (found != free_blocks_by_size_.end()) {
+                block_to_use = found->second;
             }
         } 
         // --- WORST FIT: Usar el bloque más grande disponible ---
+        // (el de mayor tamaño del índice; entre iguales, el de menor dirección)
         else if (allocation_algorithm_ == 3) {
-            int max_size = -1;  // Tamaño máximo inicializado a -1
-            
-            for (auto it = dynamic_memory_.begin(); it != dynamic_memory_.end(); ++it) {
-                if (it->is_free && it->size >= process_size && it->size > max_size) {
-                    max_size = it->size;  // Actualizar tamaño máximo
-                    block_to_use = it;
+            if (!free_blocks_by_size_.empty()) {
+                int max_size = prev(free_blocks_by_size_.end())->first.first;
+                if (max_size >= process_size) {
+                    block_to_use = free_blocks_by_size_.lower_bound(make_pair(max_size, numeric_limits<int>::min()))->second;
                 }
             }
         }
@@ -210,23 +290,27 @@ private:
         // Si se encontró un bloque adecuado, asignar el proceso
         if (block_to_use != dynamic_memory_.end()) {
             process_sizes_[process_id] = process_size;  // Guardar tamaño real del proceso
+            removeFreeBlock(block_to_use);  // Deja de estar libre
             
             // Si el bloque es mayor que el proceso, dividirlo
             if (block_to_use->size > process_size) {
                 // Crear un nuevo bloque libre con el espacio restante
-                MemoryBlock new_free_block(next_block_id_++, block_to_use->size - process_size, true);
+                MemoryBlock new_free_block(next_block_id_++, block_to_use->size - process_size, true, "",
+                                           block_to_use->start + process_size);
                 block_to_use->size = process_size;  // Ajustar tamaño del bloque actual
-                dynamic_memory_.insert(next(block_to_use), new_free_block);  // Insertar nuevo bloque
+                addFreeBlock(dynamic_memory_.insert(next(block_to_use), new_free_block));  // Insertar nuevo bloque
             }
             
             // Marcar el bloque como ocupado
             block_to_use->is_free = false;
             block_to_use->process_id = process_id;
+            dynamic_blocks_by_process_[process_id].push_back(block_to_use);
             cout << " -> Proceso " << process_id << " asignado." << endl;
         } else {
             // No se encontró un bloque suficientemente grande
             cout << "Error: No hay espacio suficiente para el proceso " << process_id << "." << endl;
         }
+        return block_to_use;
     }
     
     // ========================================================================
@@ -291,23 +375,19 @@ private:
     // Libera la memoria ocupada por un proceso en particionamiento dinámico
     // ========================================================================
     void liberateDynamic(const string& process_id) {
-        bool found = false;
-        
-        // Buscar y liberar todos los bloques del proceso
-        for (auto& block : dynamic_memory_) {
-            if (!block.is_free && block.process_id == process_id) {
-                block.is_free = true;        // Marcar como libre
-                block.process_id = "";       // Limpiar ID del proceso
-                process_sizes_.erase(process_id);  // Eliminar del registro de tamaños
-                found = true;
-            }
-        }
-        
-        // Si se liberó el proceso, fusionar bloques libres contiguos
-        if (found)
-            mergeFreeBlocks();
-        else
+        // Buscar los bloques del proceso en el índice
+        auto found = dynamic_blocks_by_process_.find(process_id);
+        if (found == dynamic_blocks_by_process_.end()) {
             cout << "Error: Proceso " << process_id << " no encontrado." << endl;
+            return;
+        }
+
+        // Liberar todos los bloques del proceso, fusionando cada uno con sus vecinos
+        for (BlockHandle block : found->second) {
+            releaseBlock(block);
+        }
+        dynamic_blocks_by_process_.erase(found);
+        process_sizes_.erase(process_id);  // Eliminar del registro de tamaños
     }
 
     // ========================================================================
@@ -329,6 +409,111 @@ private:
         cout << "Error: Proceso " << process_id << " no encontrado." << endl;
     }
 
+    // ========================================================================
+    // MÉTODO: initBuddy
+    // Prepara las listas libres y el bitmap del sistema buddy. La memoria se
+    // descompone en potencias de 2 (ej. 100 = 64 + 32 + 4) y cada región
+    // empieza como un solo bloque libre
+    // ========================================================================
+    void initBuddy() {
+        int orders = 1;
+        while ((1LL << orders) <= total_memory_size_) orders++;
+        buddy_free_lists_.assign(orders, set<int>());
+        buddy_free_bitmap_.assign(orders, vector<bool>());
+        for (int k = 0; k < orders; ++k) {
+            buddy_free_bitmap_[k].assign((total_memory_size_ >> k) + 1, false);
+        }
+
+        int start = 0;
+        for (int k = orders - 1; k >= 0; --k) {
+            if (total_memory_size_ & (1 << k)) {
+                buddy_regions_[start] = k;
+                addBuddyFree(start, k);
+                start += 1 << k;
+            }
+        }
+    }
+
+    // ========================================================================
+    // MÉTODOS: addBuddyFree / removeBuddyFree
+    // Mantienen juntas la lista libre de cada orden y el bitmap
+    // ========================================================================
+    void addBuddyFree(int start, int order) {
+        buddy_free_lists_[order].insert(start);
+        buddy_free_bitmap_[order][start >> order] = true;
+    }
+
+    void removeBuddyFree(int start, int order) {
+        buddy_free_lists_[order].erase(start);
+        buddy_free_bitmap_[order][start >> order] = false;
+    }
+
+    // ========================================================================
+    // MÉTODO: allocateBuddy
+    // Asigna a un proceso el bloque de potencia de 2 más chico que lo contiene.
+    // Toma el primer orden con bloques libres y lo divide a la mitad hasta
+    // llegar al tamaño pedido: O(log N)
+    // ========================================================================
+    void allocateBuddy(const string& process_id, int process_size) {
+        // Orden del bloque más chico que alcanza para el proceso
+        int order = 0;
+        while ((1LL << order) < process_size) order++;
+
+        // Buscar el primer orden con un bloque libre
+        int available = order;
+        while (available < (int)buddy_free_lists_.size() && buddy_free_lists_[available].empty()) {
+            available++;
+        }
+        if (available >= (int)buddy_free_lists_.size()) {
+            cout << "Error: No hay un bloque libre suficientemente grande para el proceso " << process_id << "." << endl;
+            return;
+        }
+
+        // Usar el de menor dirección y dividirlo; cada mitad alta queda libre
+        int start = *buddy_free_lists_[available].begin();
+        removeBuddyFree(start, available);
+        while (available > order) {
+            available--;
+            addBuddyFree(start + (1 << available), available);
+        }
+
+        buddy_allocated_[start] = make_pair(order, process_id);
+        buddy_blocks_by_process_[process_id].push_back(start);
+        process_sizes_[process_id] = process_size;  // Guardar tamaño real para calcular fragmentación
+        cout << " -> Proceso " << process_id << " asignado a un bloque de " << (1 << order) << endl;
+    }
+
+    // ========================================================================
+    // MÉTODO: liberateBuddy
+    // Libera los bloques de un proceso y los fusiona con su buddy mientras
+    // el buddy esté libre (lo dice el bitmap), sin salir de su región
+    // ========================================================================
+    void liberateBuddy(const string& process_id) {
+        auto found = buddy_blocks_by_process_.find(process_id);
+        if (found == buddy_blocks_by_process_.end()) {
+            cout << "Error: Proceso " << process_id << " no encontrado." << endl;
+            return;
+        }
+
+        for (int start : found->second) {
+            int order = buddy_allocated_[start].first;
+            buddy_allocated_.erase(start);
+            int region_order = prev(buddy_regions_.upper_bound(start))->second;
+
+            // El buddy de un bloque de orden k difiere solo en el bit k de su inicio
+            while (order < region_order) {
+                int buddy = start ^ (1 << order);
+                if (!buddy_free_bitmap_[order][buddy >> order]) break;
+                removeBuddyFree(buddy, order);
+                start = min(start, buddy);
+                order++;
+            }
+            addBuddyFree(start, order);
+        }
+        buddy_blocks_by_process_.erase(found);
+        process_sizes_.erase(process_id);  // Eliminar del registro de tamaños
+    }
+
 public:
     // ========================================================================
     // CONSTRUCTOR
@@ -354,7 +539,7 @@ public:
 
         // --- PASO 2: Elegir esquema de particionamiento ---
         int scheme_choice;
-        cout << "\nElija un esquema de particionamiento:\n  1. Fijo\n  2. Dinamico\nOpcion: ";
+        cout << "\nElija un esquema de particionamiento:\n  1. Fijo\n  2. Dinamico\n  3. Buddy\nOpcion: ";
         cin >> scheme_choice;
 
         if (scheme_choice == 1) {
@@ -387,6 +572,13 @@ public:
             cout << "\n--- Configurando Particionamiento Dinamico ---\n";
             // Iniciar con un solo bloque libre del tamaño total de memoria
             dynamic_memory_.emplace_back(0, total_memory_size_, true);
+            addFreeBlock(dynamic_memory_.begin());
+        } 
+        else if (scheme_choice == 3) {
+            // --- CONFIGURAR SISTEMA BUDDY ---
+            partition_scheme_str = "BUDDY";
+            cout << "\n--- Configurando Sistema Buddy ---\n";
+            initBuddy();
         } 
         else {
             cout << "Opcion no valida. Saliendo.\n";
@@ -394,9 +586,12 @@ public:
         }
 
         // --- PASO 3: Elegir algoritmo de asignación ---
-        cout << "\nElija un algoritmo de asignacion:\n";
-        cout << "  1. First Fit\n  2. Best Fit\n  3. Worst Fit\nOpcion: ";
-        cin >> allocation_algorithm_;
+        // (el sistema buddy siempre usa el bloque de potencia de 2 más chico)
+        if (partition_scheme_str != "BUDDY") {
+            cout << "\nElija un algoritmo de asignacion:\n";
+            cout << "  1. First Fit\n  2. Best Fit\n  3. Worst Fit\nOpcion: ";
+            cin >> allocation_algorithm_;
+        }
 
         // --- PASO 4: Procesar comandos ---
         cout << "\nMemoria inicializada. Ingrese los comandos " << endl;